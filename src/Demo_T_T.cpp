@@ -1,80 +1,397 @@
-#include <iostream>
-#include <fstream>
-#include <cstring>
-#include "IRCNetSDK.h"
-#include "IRCNetSDKDef.h"
-
-static bool g_tempSaved = false;
-
-// 콜백 함수: 온도 데이터를 수신하고 CSV 및 TXT 파일로 저장
-// IRC_NET_HANDLE 연결 식별자, IRC_NET_TEMP_INFO_CB* tempInfo 온도 정보 콜백 구조체, IRC_NET_TEMP_EXT_INFO_CB* 확장 정보 콜백 구조체, void* 사용자 데이터
-// IRC_NET_TEMP_INFO_CB* tempInfo 클래스 인건가? -> 사용하는데??
-void TempCallback_V2(IRC_NET_HANDLE, IRC_NET_TEMP_INFO_CB* tempInfo, IRC_NET_TEMP_EXT_INFO_CB*, void*) {
-    if (g_tempSaved || !tempInfo || !tempInfo->temp) return; // 이미 저장된 경우 또는 유효하지 않은 온도 정보가 있는 경우 함수 종료
-    g_tempSaved = true; // 한번만 저장
-
-    unsigned int width = tempInfo->width;
-    unsigned int height = tempInfo->height;
-    unsigned short* tempArray = reinterpret_cast<unsigned short*>(tempInfo->temp); //원시 온도 배열
-
-    // 파일 열기
-    std::ofstream ofs_csv("temperature_map.csv");
-    std::ofstream ofs_txt("temperature_map.txt");
-
-    if (!ofs_csv || !ofs_txt) {
-        std::cerr << "Failed to open output files\n";
-        return;
-    }
-
-    // 온도 데이터 저장 루프
-    for (unsigned int y = 0; y < height; ++y) {
-        for (unsigned int x = 0; x < width; ++x) {
-            unsigned short raw = tempArray[y * width + x];
-            // raw 값을 섭씨로 변환
-            float tempC = raw / 10.0f - 273.15f;  // Temperature Cal (°C)
-
-            ofs_csv << tempC;
-            ofs_txt << tempC;
-
-            if (x != width - 1) {
-                ofs_csv << ",";
-                ofs_txt << " ";
-            }
-        }
-        ofs_csv << "\n";
-        ofs_txt << "\n";
-    }
-
-    // 완료 메세지
-    std::cout << "[Temp] Temperature map saved to 'temperature_map.csv' and 'temperature_map.txt' (" 
-              << width << "x" << height << ")\n";
-}
-
-int main() {
-    IRC_NET_Init(); // Initialize the SDK
-
-    IRC_NET_LOGIN_INFO loginInfo; // 템플릿 / 클래스의 변수 호출 -> 그런데 변수가 템플릿 형태 or key는 . 사용
-    std::strcpy(loginInfo.ip, "192.168.1.123"); // 자동으로 배치된 쓰레기값 지우려고, std::strcpy 무조건 카피
-    loginInfo.port = 80; // char 사용시에는 카피로 int는 대입
-    std::strcpy(loginInfo.username, "admin");
-    std::strcpy(loginInfo.password, "admin");
-
-    IRC_NET_HANDLE handle;
-    if (IRC_NET_Login(&loginInfo, &handle) != IRC_NET_ERROR_OK) { // &로 변수의 주소를 가져옴. 이 함수는 로그인시도로 성공하면 handle을 반환하고 실패하면 오류코드를 반환한다.
-        std::cerr << "Login failed\n"; // std::cerr는 표준 오류 스트림을 나타내며, 주로 오류 메시지를 출력하는 데 사용된다
-        return -1;
-    }
-
-    IRC_NET_PREVIEW_INFO previewInfo{1, IRC_NET_STREAM_MAIN, IRC_NET_FRAME_FMT_RGBA}; // 1번 채널, 메인 스트림, RGBA 프레임 포맷 여러개임 참고~
-    IRC_NET_StartPreview_V2(handle, &previewInfo, nullptr, nullptr); //Start live view
-    IRC_NET_StartPullTemp_V2(handle, TempCallback_V2, nullptr); //Start pulling temperature data
-
-    std::cout << "Press Enter to exit...\n"; // Std::cout는 표준 출력 스트림을 나타내며, 주로 프로그램의 일반적인 출력을 표시하는 데 사용된다
-    std::cin.get(); // 사용자가 키보드에서 Enter 키를 누를 때까지 대기한다
-
-    IRC_NET_StopPullTemp(handle); // Stop pulling temperature data
-    IRC_NET_StopPreview(handle); // Stop live view
-    IRC_NET_Logout(handle); // Logout from the device
-    IRC_NET_Deinit(); // Deinitialize the SDK
-    return 0;
-}
\ No newline at end of file
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <unistd.h>
+#include "IRCNetSDK.h"
+#include "IRCNetSDKDef.h"
+#include "infiray_ros2/device_policy.hpp"
+
+// 사용법:
+//   Demo_T_T                                 한 프레임을 temperature_map.csv / .txt 로 저장 (기존 동작)
+//   Demo_T_T --frames 5000 --npy --no-txt    5000 프레임 연속 저장 (0 이면 Enter 까지, N 프레임 중에도 Enter 로 중단)
+// 옵션: --ip <주소> --prefix <경로 앞부분> --csv/--no-csv --txt/--no-txt --npy (float32 섭씨) --npy-raw (uint16 원시)
+//       --queue <프레임 수> (콜백 -> 기록 스레드 버퍼, 넘치면 버림)
+// 빌드 시 온도 변환 정책 헤더를 위해 -I infiray_ros2/include 를 준다.
+
+// IRC_NET_StartPullTemp_V2 온도 버퍼 (0.1 K 단위 uint16). 변환/LUT 는 장치 정책이 만든다.
+using Device = infiray::DeviceIrcNet;
+
+// ---- 내보내기 설정 ----
+struct ExportOptions {
+    std::string ip = "192.168.1.123";
+    std::string prefix = "temperature_map";
+    long frames = 1;         // 0 이면 Enter 를 누를 때까지
+    bool csv = true;
+    bool txt = true;
+    bool npyCelsius = false;  // <prefix>_c.npy   (N, H, W) float32 섭씨
+    bool npyRaw = false;      // <prefix>_raw.npy (N, H, W) uint16, 0.1 K 단위 원시값
+    size_t queueFrames = 64;
+};
+
+struct Frame {
+    long index = 0;
+    unsigned width = 0, height = 0;
+    std::vector<uint16_t> raw;
+};
+
+// ---- 여러 프레임을 하나로 쌓는 .npy 기록기 ----
+// 헤더를 128 바이트로 잡아 두고 프레임을 이어 붙인 뒤, 닫을 때 프레임 수(shape[0])를 고쳐 쓴다.
+class NpyStackWriter {
+public:
+    ~NpyStackWriter() { close(); }
+
+    bool open(const std::string &path, const char *descr, size_t elemBytes, unsigned width, unsigned height) {
+        fp_ = std::fopen(path.c_str(), "wb");
+        if (!fp_) return false;
+        path_ = path;
+        descr_ = descr;
+        elemBytes_ = elemBytes;
+        width_ = width;
+        height_ = height;
+        count_ = 0;
+        return writeHeader();
+    }
+
+    bool append(const void *data) {
+        const size_t n = (size_t)width_ * height_;
+        if (std::fwrite(data, elemBytes_, n, fp_) != n) return false;
+        count_++;
+        return true;
+    }
+
+    void close() {
+        if (!fp_) return;
+        std::fseek(fp_, 0, SEEK_SET);
+        writeHeader();
+        std::fclose(fp_);
+        fp_ = nullptr;
+    }
+
+    bool isOpen() const { return fp_ != nullptr; }
+    unsigned width() const { return width_; }
+    unsigned height() const { return height_; }
+
+private:
+    static constexpr size_t kHeaderBytes = 128;  // 매직 + 버전 + 길이 + dict, 64 바이트 정렬
+
+    bool writeHeader() {
+        char header[kHeaderBytes];
+        std::memset(header, ' ', sizeof(header));
+        std::memcpy(header, "\x93NUMPY\x01\x00", 8);
+        const uint16_t dictLen = (uint16_t)(kHeaderBytes - 10);
+        header[8] = (char)(dictLen & 0xFF);
+        header[9] = (char)(dictLen >> 8);
+        const int n = std::snprintf(header + 10, dictLen, "{'descr': '%s', 'fortran_order': False, 'shape': (%lu, %u, %u), }",
+                                    descr_, (unsigned long)count_, height_, width_);
+        header[10 + n] = ' ';  // snprintf 의 '\0' 을 공백으로
+        header[kHeaderBytes - 1] = '\n';
+        return std::fwrite(header, 1, sizeof(header), fp_) == sizeof(header);
+    }
+
+    std::FILE *fp_ = nullptr;
+    std::string path_;
+    const char *descr_ = "";
+    size_t elemBytes_ = 0;
+    unsigned width_ = 0, height_ = 0;
+    unsigned long count_ = 0;
+};
+
+// ---- 0.01 C 단위 정수를 "-12.34" 형태로 (부동소수 변환 없이 to_chars 로) ----
+// raw 는 0.1 K 단위라 raw / 10 - 273.15 는 소수 둘째 자리에서 정확히 떨어진다
+static inline char *formatCenti(char *p, char *end, int centi) {
+    if (centi < 0) {
+        *p++ = '-';
+        centi = -centi;
+    }
+    p = std::to_chars(p, end, centi / 100).ptr;
+    const int frac = centi % 100;
+    p[0] = '.';
+    p[1] = (char)('0' + frac / 10);
+    p[2] = (char)('0' + frac % 10);
+    return p + 3;
+}
+
+// ---- 콜백 -> 기록 스레드 ----
+// 콜백은 미리 만든 버퍼에 원시 배열을 복사해 큐에 넣기만 한다. 버퍼가 다 차 있으면 그 프레임은 버린다.
+// 변환/서식/파일 쓰기는 모두 기록 스레드에서 한다.
+class TempExporter {
+public:
+    explicit TempExporter(const ExportOptions &opts) : opts_(opts) {
+        free_.resize(std::max<size_t>(1, opts_.queueFrames));
+    }
+
+    ~TempExporter() { stop(); }
+
+    void start() { thread_ = std::thread(&TempExporter::run, this); }
+
+    // 큐에 남은 프레임까지 쓰고 끝낸다
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) thread_.join();
+    }
+
+    // SDK 콜백에서 부른다 (기다리지 않음). 받은 프레임 수가 목표에 닿으면 false.
+    bool push(const uint16_t *raw, unsigned width, unsigned height) {
+        Frame f;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (stopping_ || (opts_.frames > 0 && accepted_ >= opts_.frames)) return false;
+            if (free_.empty()) {
+                dropped_++;
+                return true;
+            }
+            f = std::move(free_.back());
+            free_.pop_back();
+            f.index = accepted_++;
+        }
+        f.width = width;
+        f.height = height;
+        f.raw.assign(raw, raw + (size_t)width * height);  // 같은 해상도면 재할당 없음
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            pending_.push_back(std::move(f));
+        }
+        cv_.notify_all();
+        return true;
+    }
+
+    // 목표 프레임 수를 다 썼으면 true. 최대 timeout 만큼 기다린다 (frames == 0 이면 바로 false).
+    bool waitDoneFor(std::chrono::milliseconds timeout) {
+        if (opts_.frames <= 0) return false;
+        std::unique_lock<std::mutex> lk(mtx_);
+        return doneCv_.wait_for(lk, timeout, [this] { return written_ >= opts_.frames; });
+    }
+
+    long written() const { std::lock_guard<std::mutex> lk(mtx_); return written_; }
+    long dropped() const { std::lock_guard<std::mutex> lk(mtx_); return dropped_; }
+    double writeSeconds() const { return writeNs_ * 1e-9; }
+
+private:
+    void run() {
+        Frame f;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(mtx_);
+                cv_.wait(lk, [this] { return !pending_.empty() || stopping_; });
+                if (pending_.empty()) break;
+                f = std::move(pending_.front());
+                pending_.pop_front();
+            }
+            const auto t0 = std::chrono::steady_clock::now();
+            writeFrame(f);
+            writeNs_ += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - t0).count();
+            {
+                std::lock_guard<std::mutex> lk(mtx_);
+                free_.push_back(std::move(f));
+                written_++;
+            }
+            doneCv_.notify_all();
+        }
+        npyCelsius_.close();
+        npyRaw_.close();
+    }
+
+    std::string framePath(long index, const char *ext) const {
+        if (opts_.frames == 1) return opts_.prefix + ext;  // 한 장이면 기존 파일 이름 그대로
+        char num[16];
+        std::snprintf(num, sizeof(num), "_%06ld", index);
+        return opts_.prefix + num + ext;
+    }
+
+    static bool writeFile(const std::string &path, const char *data, size_t len) {
+        std::FILE *fp = std::fopen(path.c_str(), "wb");
+        if (!fp) return false;
+        const bool ok = std::fwrite(data, 1, len, fp) == len;
+        return std::fclose(fp) == 0 && ok;
+    }
+
+    void writeFrame(const Frame &f) {
+        const unsigned w = f.width, h = f.height;
+        if (w == 0 || h == 0) return;  // 빈 프레임 (아래 줄 끝 처리가 버퍼 앞을 쓰지 않도록)
+        const size_t n = (size_t)w * h;
+
+        if (opts_.npyCelsius || opts_.npyRaw) {
+            // 스택은 첫 프레임 해상도로 고정, 다른 해상도는 건너뛴다
+            if (opts_.npyRaw && !npyRaw_.isOpen() && !npyRaw_.open(opts_.prefix + "_raw.npy", "<u2", 2, w, h)) {
+                std::cerr << "Failed to open " << opts_.prefix << "_raw.npy\n";
+                opts_.npyRaw = false;
+            }
+            if (opts_.npyCelsius && !npyCelsius_.isOpen() && !npyCelsius_.open(opts_.prefix + "_c.npy", "<f4", 4, w, h)) {
+                std::cerr << "Failed to open " << opts_.prefix << "_c.npy\n";
+                opts_.npyCelsius = false;
+            }
+            if (npyRaw_.isOpen() && npyRaw_.width() == w && npyRaw_.height() == h) npyRaw_.append(f.raw.data());
+            if (npyCelsius_.isOpen() && npyCelsius_.width() == w && npyCelsius_.height() == h) {
+                celsius_.resize(n);
+                infiray::rawToCelsiusFrame<Device>(f.raw.data(), n, celsius_.data());  // Temperature Cal (°C)
+                npyCelsius_.append(celsius_.data());
+            }
+        }
+
+        if (!opts_.csv && !opts_.txt) return;
+
+        // 값당 최대 "-273.15," 8 글자 + 줄바꿈
+        text_.resize(n * 8 + h + 16);
+        char *p = text_.data();
+        char *const end = text_.data() + text_.size();
+        for (unsigned y = 0; y < h; ++y) {
+            const uint16_t *row = f.raw.data() + (size_t)y * w;
+            for (unsigned x = 0; x < w; ++x) {
+                p = formatCenti(p, end, Device::toCentiCelsius(row[x]));
+                *p++ = ',';
+            }
+            p[-1] = '\n';  // 마지막 쉼표 자리
+        }
+        const size_t len = (size_t)(p - text_.data());
+
+        if (opts_.csv && !writeFile(framePath(f.index, ".csv"), text_.data(), len)) {
+            std::cerr << "Failed to write " << framePath(f.index, ".csv") << "\n";
+        }
+        if (opts_.txt) {
+            // TXT 는 구분자만 공백
+            txt_.resize(len);
+            std::replace_copy(text_.data(), text_.data() + len, txt_.data(), ',', ' ');
+            if (!writeFile(framePath(f.index, ".txt"), txt_.data(), len)) {
+                std::cerr << "Failed to write " << framePath(f.index, ".txt") << "\n";
+            }
+        }
+    }
+
+    ExportOptions opts_;
+    std::thread thread_;
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::condition_variable doneCv_;
+    std::deque<Frame> pending_;
+    std::vector<Frame> free_;
+    long accepted_ = 0;
+    long written_ = 0;
+    long dropped_ = 0;
+    bool stopping_ = false;
+
+    // ---- 기록 스레드 전용 (프레임 간 재사용) ----
+    std::vector<char> text_, txt_;
+    std::vector<float> celsius_;
+    NpyStackWriter npyCelsius_, npyRaw_;
+    uint64_t writeNs_ = 0;
+};
+
+// 콜백 함수: 온도 데이터를 받아 기록 스레드로 넘긴다 (파일 쓰기는 콜백 스레드에서 하지 않음)
+// IRC_NET_HANDLE 연결 식별자, IRC_NET_TEMP_INFO_CB* tempInfo 온도 정보 콜백 구조체, IRC_NET_TEMP_EXT_INFO_CB* 확장 정보 콜백 구조체, void* 사용자 데이터 (TempExporter*)
+void TempCallback_V2(IRC_NET_HANDLE, IRC_NET_TEMP_INFO_CB* tempInfo, IRC_NET_TEMP_EXT_INFO_CB*, void* userData) {
+    auto* exporter = static_cast<TempExporter*>(userData);
+    if (!exporter || !tempInfo || !tempInfo->temp) return; // 유효하지 않은 온도 정보가 있는 경우 함수 종료
+
+    unsigned short* tempArray = reinterpret_cast<unsigned short*>(tempInfo->temp); //원시 온도 배열 (0.1 K 단위)
+    exporter->push(tempArray, tempInfo->width, tempInfo->height);
+}
+
+// Enter 가 눌렸으면 true (기다리지 않음). stdin 이 닫혀 있으면(EOF) 이후로는 보지 않는다.
+static bool enterPressed() {
+    static bool closed = false;
+    if (closed) return false;
+    pollfd pfd{STDIN_FILENO, POLLIN, 0};
+    if (poll(&pfd, 1, 0) <= 0) return false;
+    char c;
+    const ssize_t n = ::read(STDIN_FILENO, &c, 1);
+    if (n <= 0) {
+        closed = true;
+        return false;
+    }
+    return true;
+}
+
+static bool parseArgs(int argc, char** argv, ExportOptions& opts) {
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+        if (a == "--frames") { const char* v = next(); if (!v) return false; opts.frames = std::atol(v); }
+        else if (a == "--ip") { const char* v = next(); if (!v) return false; opts.ip = v; }
+        else if (a == "--prefix") { const char* v = next(); if (!v) return false; opts.prefix = v; }
+        else if (a == "--queue") { const char* v = next(); if (!v) return false; opts.queueFrames = (size_t)std::atol(v); }
+        else if (a == "--csv") opts.csv = true;
+        else if (a == "--no-csv") opts.csv = false;
+        else if (a == "--txt") opts.txt = true;
+        else if (a == "--no-txt") opts.txt = false;
+        else if (a == "--npy") opts.npyCelsius = true;
+        else if (a == "--npy-raw") opts.npyRaw = true;
+        else return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    ExportOptions opts;
+    if (!parseArgs(argc, argv, opts)) {
+        std::cerr << "Usage: Demo_T_T [--frames N] [--ip ADDR] [--prefix PATH] [--csv|--no-csv] [--txt|--no-txt]"
+                     " [--npy] [--npy-raw] [--queue N]\n";
+        return -1;
+    }
+
+    IRC_NET_Init(); // Initialize the SDK
+
+    IRC_NET_LOGIN_INFO loginInfo; // 템플릿 / 클래스의 변수 호출 -> 그런데 변수가 템플릿 형태 or key는 . 사용
+    std::strcpy(loginInfo.ip, opts.ip.c_str()); // 자동으로 배치된 쓰레기값 지우려고, std::strcpy 무조건 카피
+    loginInfo.port = 80; // char 사용시에는 카피로 int는 대입
+    std::strcpy(loginInfo.username, "admin");
+    std::strcpy(loginInfo.password, "admin");
+
+    IRC_NET_HANDLE handle;
+    if (IRC_NET_Login(&loginInfo, &handle) != IRC_NET_ERROR_OK) { // &로 변수의 주소를 가져옴. 이 함수는 로그인시도로 성공하면 handle을 반환하고 실패하면 오류코드를 반환한다.
+        std::cerr << "Login failed\n"; // std::cerr는 표준 오류 스트림을 나타내며, 주로 오류 메시지를 출력하는 데 사용된다
+        return -1;
+    }
+
+    TempExporter exporter(opts);
+    exporter.start();
+
+    IRC_NET_PREVIEW_INFO previewInfo{1, IRC_NET_STREAM_MAIN, IRC_NET_FRAME_FMT_RGBA}; // 1번 채널, 메인 스트림, RGBA 프레임 포맷 여러개임 참고~
+    IRC_NET_StartPreview_V2(handle, &previewInfo, nullptr, nullptr); //Start live view
+    IRC_NET_StartPullTemp_V2(handle, TempCallback_V2, &exporter); //Start pulling temperature data
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (opts.frames > 0) {
+        // 온도 프레임이 오지 않아도 Enter 로 끝낼 수 있게 기다리는 중에 stdin 을 본다
+        std::cout << "Exporting " << opts.frames << " frame(s) (Enter to stop early)...\n";
+        while (!exporter.waitDoneFor(std::chrono::milliseconds(200))) {
+            if (enterPressed()) break;
+        }
+    } else {
+        std::cout << "Exporting until Enter is pressed...\n"; // Std::cout는 표준 출력 스트림을 나타내며, 주로 프로그램의 일반적인 출력을 표시하는 데 사용된다
+        std::cin.get(); // 사용자가 키보드에서 Enter 키를 누를 때까지 대기한다
+    }
+
+    IRC_NET_StopPullTemp(handle); // Stop pulling temperature data
+    IRC_NET_StopPreview(handle); // Stop live view
+    exporter.stop(); // 큐에 남은 프레임까지 기록
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    // 완료 메세지
+    const long written = exporter.written();
+    std::cout << "[Temp] Exported " << written << " frame(s) to '" << opts.prefix << "*' in " << elapsed << " s"
+              << " (dropped " << exporter.dropped() << ", write " << (written > 0 ? exporter.writeSeconds() * 1e3 / written : 0.0)
+              << " ms/frame)\n";
+
+    IRC_NET_Logout(handle); // Logout from the device
+    IRC_NET_Deinit(); // Deinitialize the SDK
+    return 0;
+}
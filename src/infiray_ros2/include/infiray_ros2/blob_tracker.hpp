@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace infiray {
+
+// ---- 고온 덩어리 분할/추적 설정 ----
+struct BlobTrackerConfig {
+    double thresholdC = 60.0;      // 이 온도 이상 픽셀을 덩어리로 본다
+    int minArea = 20;              // 이보다 작은 덩어리는 노이즈로 버림
+    int maxBlobs = 32;             // 프레임당 면적 큰 순으로 최대 개수
+    double maxMatchDistPx = 40.0;  // 예측 위치와 이 거리 안이면 같은 덩어리
+    int maxMissedFrames = 5;       // 이만큼 안 보이면 추적 종료
+    double velocitySmoothing = 0.5;  // 속도 EMA 계수 (1 이면 평활 없음)
+};
+
+struct TrackedBlob {
+    uint32_t id = 0;
+    float cx = 0.0f, cy = 0.0f;  // 중심
+    int area = 0;
+    int x = 0, y = 0, w = 0, h = 0;  // 외접 사각형
+    float maxCelsius = 0.0f;
+    float meanCelsius = 0.0f;
+    float vx = 0.0f, vy = 0.0f;  // 픽셀/초
+    uint32_t age = 0;            // 추적된 프레임 수
+    int missed = 0;              // 연속으로 안 보인 프레임 수
+};
+
+// ---- 임계값 + 연결 요소 + 프레임 간 연관 ----
+// 분할은 행 단위 run 으로 하고 run 끼리 union-find 로 잇는다 (8-연결).
+// 임계값 비교는 rawToKelvin30 정수로 하므로 구간별 변환식의 비단조 구간에서도 섭씨 기준과 같다.
+// 연관은 예측 위치(중심 + 속도 * dt) 와의 거리 순 greedy 매칭이다.
+// 버퍼는 모두 프레임 간 재사용한다.
+class BlobTracker {
+public:
+    explicit BlobTracker(const BlobTrackerConfig &cfg = BlobTrackerConfig());
+
+    // 이번 프레임에서 보인 덩어리 (ID 순)
+    const std::vector<TrackedBlob> &update(const uint16_t *temp, int width, int height, uint64_t captureNs);
+    const std::vector<TrackedBlob> &visible() const { return visible_; }
+
+private:
+    struct Run {
+        int y, x0, x1;  // x1 포함
+        int parent;
+    };
+    struct Component {
+        int area = 0;
+        int64_t sumX = 0, sumY = 0, sumK30 = 0;
+        int32_t maxK30 = 0;
+        int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    };
+
+    int findRoot(int i);
+    void segment(const uint16_t *temp, int width, int height);
+    void associate(double dt);
+
+    BlobTrackerConfig cfg_;
+    int32_t thresholdK30_;
+    uint32_t nextId_ = 1;
+    uint64_t lastNs_ = 0;
+
+    std::vector<uint8_t> rowMask_;
+    std::vector<Run> runs_;
+    std::vector<int> rootToComp_;
+    std::vector<Component> comps_;
+    std::vector<TrackedBlob> detections_;
+    std::vector<TrackedBlob> tracks_;
+    std::vector<TrackedBlob> visible_;
+    struct Pair { float d2; int track, det; };
+    std::vector<Pair> pairs_;
+    std::vector<char> trackUsed_, detUsed_;
+};
+
+}  // namespace infiray
@@ -0,0 +1,307 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "rclcpp/rclcpp.hpp"
+#include "sensor_msgs/msg/camera_info.hpp"
+#include "sensor_msgs/msg/compressed_image.hpp"
+#include "std_msgs/msg/bool.hpp"
+#include "std_msgs/msg/float32.hpp"
+#include "std_msgs/msg/float64_multi_array.hpp"
+#include "diagnostic_msgs/msg/diagnostic_status.hpp"
+#include "cv_bridge/cv_mat_sensor_msgs_image_type_adapter.hpp"
+#include "infiray_ros2/msg/hotspot_array.hpp"
+#include "infiray_ros2/msg/thermal_blob_array.hpp"
+#include "infiray_ros2/msg/thermal_stats_array.hpp"
+
+#include "infiray_ros2/frame_record.hpp"
+#include "infiray_ros2/mmap_recorder.hpp"
+#include "infiray_ros2/shm_ring.hpp"
+#include "infiray_ros2/frame_ring.hpp"
+#include "infiray_ros2/blob_tracker.hpp"
+#include "infiray_ros2/device_policy.hpp"
+#include "infiray_ros2/fire_detector.hpp"
+#include "infiray_ros2/frame_source.hpp"
+#include "infiray_ros2/frame_stats.hpp"
+#include "infiray_ros2/hotspot.hpp"
+#include "infiray_ros2/latency_stats.hpp"
+#include "infiray_ros2/latest_queue.hpp"
+#include "infiray_ros2/palette.hpp"
+#include "infiray_ros2/rt_tuning.hpp"
+
+namespace infiray_ros2 {
+
+// ---- 모든 카메라가 공유하는 처리 설정 (노드 파라미터) ----
+struct SessionOptions {
+    bool showDisplay = false;
+    bool publishOverlay = true;
+    bool publishRaw = true;
+    std::vector<int> hotspotSizes{30};
+    int hotspotTopK = 1;
+    int queueDepth = 1;  // 단계 사이 큐 길이 (넘치면 오래된 프레임부터 버림)
+    bool captureYOnly = true;  // 영상 콜백에서 Y 평면만 링으로 복사 (하류는 Y 만 쓴다)
+    // 오버레이 팔레트 (kPaletteNames 중 하나, 화면 창에서 숫자 키로 바꿀 수 있다)
+    std::string palette = "gray";
+    // [최저, 최고] 섭씨. 주면 Y(AGC) 대신 짝지은 온도 raw 를 이 범위로 칠한다 (프레임마다 색이 안 바뀜)
+    std::vector<double> renderTempRangeC;
+    infiray::FireDetectorConfig fire;
+    bool publishFireMask = true;
+    // 오버레이 압축 발행 ("jpeg" / "png" / "none"), 인코더 스레드에서 처리
+    std::string compressedFormat = "jpeg";
+    int jpegQuality = 80;
+    int pngLevel = 1;  // 0~9, 낮을수록 빠르고 크다 (무손실은 동일)
+    bool blobsEnabled = true;
+    infiray::BlobTrackerConfig blobs;
+    bool statsEnabled = true;  // 전체/ROI 온도 통계 (/thermal/stats)
+    std::vector<double> statsPercentiles{50.0, 90.0, 99.0};
+    bool shmEnabled = false;  // 온도/오버레이를 공유 메모리 링에도 쓴다
+    int shmSlots = 4;
+    // 출력별 발행 주기 (Hz, 0 이면 처리한 프레임마다). 경보/온도/hotspots/blobs 는 항상 센서 속도.
+    double imageHz = 0.0;
+    double compressedHz = 0.0;
+    double rawHz = 0.0;
+    // 켜면 오버레이(image, compressed)는 내용이 바뀌었을 때만, 그래도 imageKeepaliveS 마다 한 번은 보낸다
+    bool imageOnChange = false;
+    double imageChangeC = 1.0;
+    double imageKeepaliveS = 1.0;
+    // 단계 스레드 CPU 고정 / SCHED_FIFO (rt.*). callback 은 SDK 콜백 스레드 (첫 콜백에서 적용).
+    infiray::ThreadTuning analyticsTuning;
+    infiray::ThreadTuning outputTuning;
+    infiray::ThreadTuning callbackTuning;
+    bool prefaultBuffers = false;  // rt.mlockall 일 때 프레임 링을 미리 채워 둔다
+    // 영상 프레임마다 캡처 시각이 가장 가까운 온도 프레임을 짝짓는다 (이 차이 안에서만)
+    double syncToleranceMs = 20.0;
+    int syncHistory = 4;  // 짝을 찾을 온도 프레임 이력 길이
+};
+
+// ---- 카메라 한 대 분량의 상태 ----
+// 버퍼, 처리 스레드, 발행자를 카메라마다 따로 가지며, SDK 콜백에는 pContext 로 this 가 넘어간다.
+// 처리는 세 단계 스레드로 나뉘고 latest-wins 큐로 이어진다.
+//   분석(analytics) : 고온 영역, 화재 검출, 덩어리 추적, max_temp / fire_* / hotspots / blobs 발행 (센서 속도 유지)
+//   출력(output)    : raw mono16 발행, 오버레이 렌더/발행
+//   화면(display)   : imshow / waitKey (show_display 일 때만)
+//   인코더(encoder) : 오버레이 JPEG/PNG 압축 발행 (compressed.format 이 none 이 아닐 때)
+// shm.enabled 이면 분석 단계가 온도를, 출력 단계가 오버레이를 공유 메모리 링에도 쓴다.
+// 뒤 단계가 느려지면 그 단계 입력 큐에서 프레임이 버려질 뿐 앞 단계는 기다리지 않는다.
+// 이름이 비어 있으면 기존 단일 카메라와 같은 파라미터/토픽 이름을 쓴다.
+//   name=""    : source, camera_ip ...    -> /thermal/image ...
+//   name="rear": rear.source, rear.camera_ip ... -> /thermal/rear/image ...
+class CameraSession {
+public:
+    using ImageContainer = cv_bridge::ROSCvMatContainer;
+
+    CameraSession(rclcpp::Node &node, const std::string &name, const SessionOptions &opts);
+    ~CameraSession();
+
+    CameraSession(const CameraSession &) = delete;
+    CameraSession &operator=(const CameraSession &) = delete;
+
+    bool start();
+    void stop();
+
+    const std::string &name() const { return name_; }
+    bool finished() const { return source_ && source_->finished(); }
+
+    // ESC 또는 소스 종료로 처리 루프가 끝났을 때 (노드가 종료 여부를 판단)
+    void setOnExit(std::function<void(CameraSession &, bool userQuit)> fn) { onExit_ = std::move(fn); }
+
+    // 지난 호출 이후 구간의 단계별 지연/처리량/버린 프레임 수 (executor 스레드에서 주기 호출).
+    // csv 가 있으면 단계별로 한 줄씩 덧붙인다.
+    diagnostic_msgs::msg::DiagnosticStatus collectDiagnostics(double periodS, std::FILE *csv, uint64_t stampNs);
+
+    // SDK 소스가 주는 온도 버퍼 형식 (InfraredTempSDK B타입)
+    using TempDevice = infiray::DeviceB;
+
+    // SDK 콜백 (pContext == CameraSession*)
+    static void videoCallBack(char *pBuffer, long BufferLen, int width, int height, void *pContext);
+    static void tempCallBack(char *pBuffer, long BufferLen, void *pContext);
+    static void endCallBack(void *pContext);
+
+private:
+    // ---- 단계 사이에 넘기는 프레임 (버퍼는 풀에서 받은 Mat 이라 참조만 옮겨진다) ----
+    struct OutputJob {
+        std_msgs::msg::Header header;      // 영상 캡처 시각 (오버레이)
+        std_msgs::msg::Header tempHeader;  // 온도 캡처 시각 (raw, fire_mask)
+        uint64_t captureNs = 0;  // 영상 콜백 시각 (capture_to_image 측정용)
+        cv::Mat y;    // 오버레이용 Y 평면 (이번 프레임에 그릴 출력이 없으면 비어 있음)
+        cv::Mat temp;  // render.temp_range_c 일 때 오버레이 바탕 (짝지은 온도 raw, 있으면 y 대신)
+        bool publishOverlay = false;  // /image 발행 차례
+        bool encode = false;          // /image/compressed 발행 차례
+        cv::Mat raw;  // 새 온도 프레임일 때만 (publish_raw)
+        cv::Mat fireMask;            // 화재 픽셀 (오버레이 표시 또는 발행용)
+        bool publishMask = false;    // 새 온도 프레임일 때만 fire_mask 로 발행
+        bool drawMask = false;       // 오버레이에 겹친다 (짝지은 온도 프레임일 때만)
+        std::vector<infiray::Hotspot> hotspots;
+        std::vector<infiray::TrackedBlob> blobs;
+    };
+
+    // ---- 짝짓기용 온도 프레임 이력 (분석 스레드 전용, 링 슬롯과 버퍼를 바꿔 끼워 복사 없음) ----
+    struct TempEntry {
+        uint64_t seq = 0;
+        uint64_t captureNs = 0;
+        int width = 0, height = 0;
+        infiray::FrameBuffer<uint16_t> data;
+    };
+
+    // ---- 오버레이 발행 판단용 요약 (on-change) ----
+    struct OverlaySignature {
+        bool fire = false;
+        int hotX = -1, hotY = -1;
+        float hotC = 0.0f;
+        size_t blobs = 0;
+    };
+    // 출력 하나의 발행 주기. 밀렸을 때 몰아서 내보내지 않도록 다음 시각은 지금 기준으로 다시 잡는다.
+    struct RateGate {
+        uint64_t periodNs = 0;  // 0 이면 매 프레임
+        uint64_t nextNs = 0;
+        uint64_t lastNs = 0;
+        OverlaySignature sent;  // 마지막으로 보낸 내용 (on-change)
+    };
+
+    std::unique_ptr<infiray::FrameSource> makeFrameSource();
+    // 이번 프레임이 이 출력의 발행 차례인지 (차례면 gate 를 갱신한다)
+    bool outputDue(RateGate &gate, uint64_t nowNs, const OverlaySignature *sig);
+    bool drainTemp();
+    const TempEntry *pairTemp(uint64_t videoNs) const;
+    const TempEntry *newestTemp() const;
+    // steady 캡처 시각 -> ROS 시각 헤더 (지금 ROS 시각에서 캡처 후 지난 시간을 뺀다)
+    std_msgs::msg::Header captureHeader(uint64_t captureNs, const rclcpp::Time &rosNow, uint64_t steadyNow) const;
+    void onVideo(char *pBuffer, long BufferLen, int width, int height);
+    void onTemp(char *pBuffer, long BufferLen);
+    void recordFrame(uint16_t videoFmt, uint16_t tempFmt, int width, int height, uint64_t captureNs,
+                     const void *video, size_t videoLen, const void *temp, size_t tempLen);
+    void wakeWorker();
+    void tuneThread(pthread_t thread, const infiray::ThreadTuning &tuning, const char *label);
+    void findHotspots(const TempEntry &temp, std::vector<infiray::Hotspot> &out);
+    bool analyzeTemp(const TempEntry &temp, OutputJob &job);
+    bool emitVideo(const infiray::FrameSlot<uint8_t> &frame, const TempEntry *temp, OutputJob &job);
+    void analyticsLoop();
+    void outputLoop();
+    void displayLoop();
+    void encoderLoop();
+
+    void publishHotspots(const std_msgs::msg::Header &header);
+    void publishBlobs(const std_msgs::msg::Header &header, const std::vector<infiray::TrackedBlob> &blobs);
+    void publishRaw(const std_msgs::msg::Header &header, const cv::Mat &raw);
+    void publishStats(const std_msgs::msg::Header &header);
+    void publishImage(const rclcpp::Publisher<ImageContainer>::SharedPtr &pub, const std_msgs::msg::Header &header,
+                      const cv::Mat &mat, const char *encoding);
+    cv::Mat renderOverlay(const OutputJob &job);
+
+    rclcpp::Node &node_;
+    std::string name_;
+    std::string paramPrefix_;  // "" 또는 "<name>."
+    std::string frameId_;
+    SessionOptions opts_;
+    std::string windowName_;
+
+    // ---- 프레임 링 (SDK 콜백 -> 처리 스레드, lock-free 최신 프레임) ----
+    // 생성자에서 kMaxPixels 기준으로 미리 할당해 두고 (영상은 capture.y_only 면 Y 평면만),
+    // 더 큰 해상도일 때만 콜백에서 재할당한다 (링의 grown() 으로 집계).
+    static constexpr size_t kMaxPixels = 1280 * 1024;
+    infiray::FrameRing<uint8_t> yuvRing_;
+    infiray::FrameRing<uint16_t> tempRing_;
+    std::atomic<int> width_{0};
+    std::atomic<int> height_{0};
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> videoCopyBytes_{0};  // 영상 콜백이 링으로 복사한 바이트
+    bool videoThreadTuned_ = false;  // 영상 콜백 스레드 전용
+    bool tempThreadTuned_ = false;   // 온도 콜백 스레드 전용
+
+    // 처리 스레드 깨우기용. 링 자체는 잠그지 않으며 mutex 는 대기 hand-off 에만 쓴다.
+    // 새 프레임, 소스 종료, stop/ESC, rclcpp 종료가 모두 깨우므로 제한 시간 없이 기다린다.
+    std::mutex wakeMtx_;
+    std::condition_variable wakeCv_;
+    rclcpp::OnShutdownCallbackHandle shutdownHandle_;
+
+    // ---- 녹화 (record_path 파라미터, 재생 소스 입력용) ----
+    // 콜백은 큐에 복사만 하고, 파일 기록은 녹화기 스레드가 한다
+    infiray::MmapRecorder recorder_;
+    std::atomic<bool> recording_{false};
+    uint16_t recordVideo_ = infiray::kVideoYOnly;  // record.video
+
+    std::unique_ptr<infiray::FrameSource> source_;
+    std::thread analytics_;
+    std::thread output_;
+    std::thread display_;
+    std::thread encoder_;
+    std::function<void(CameraSession &, bool)> onExit_;
+    std::atomic<bool> userQuit_{false};
+
+    // ---- 단계 사이 큐 (분석 -> 출력 -> 화면) ----
+    infiray::LatestQueue<OutputJob> outputQueue_;
+    infiray::LatestQueue<cv::Mat> displayQueue_;
+    struct EncodeJob {
+        std_msgs::msg::Header header;
+        cv::Mat bgr;
+    };
+    infiray::LatestQueue<EncodeJob> encodeQueue_;
+
+    // ---- 인코더 스레드 전용 (버퍼는 프레임 간 재사용) ----
+    std::string encodeExt_;  // ".jpg" / ".png", 비어 있으면 압축 발행 안 함
+    std::vector<int> encodeParams_;
+    sensor_msgs::msg::CompressedImage compressedMsg_;
+    std::atomic<uint64_t> encodedBytes_{0};
+    std::atomic<uint64_t> renderSkipped_{0};  // 발행 차례가 아니라 복사/렌더를 건너뛴 프레임
+    std::atomic<uint64_t> unpaired_{0};       // 허용 차이 안에 온도 프레임이 없던 영상 프레임
+
+    // ---- 분석 스레드 전용 ----
+    cv::Mat yPool_[4];
+    cv::Mat rawPool_[4];
+    cv::Mat maskPool_[4];
+    infiray::HotspotEngine hotspotEngine_;
+    infiray::FireDetector fireDetector_;
+    infiray::BlobTracker blobTracker_;
+    infiray::FrameStatsEngine statsEngine_;
+    std::vector<infiray::Hotspot> hotspots_;         // 가장 최근 분석한 온도 프레임 (프레임 간 재사용)
+    std::vector<infiray::Hotspot> overlayHotspots_;  // 짝지은 온도가 그보다 이전일 때 오버레이용
+    infiray::ShmFrameWriter shmTemp_;         // shm.enabled 일 때 디코딩한 온도
+    RateGate imageGate_, compressedGate_, rawGate_;
+    std::vector<TempEntry> tempHistory_;
+    size_t tempHead_ = 0;            // 가장 최근 이력
+    uint64_t analyzedTempSeq_ = 0;   // 화재/덩어리/통계를 마지막으로 갱신한 온도 프레임
+
+    // ---- 출력 스레드 전용 ----
+    cv::Mat renderPool_[4];
+    infiray::PaletteRaw paletteRaw_;  // render.temp_range_c 용 14비트 표 (팔레트가 바뀔 때만 다시 만든다)
+    int paletteRawIndex_ = -1;
+    infiray::ShmFrameWriter shmImage_;  // shm.enabled 일 때 오버레이 BGR
+    std::vector<infiray::Palette8> palettes_;  // kPaletteNames 순서
+    std::atomic<int> paletteIndex_{0};          // 화면 스레드의 키 입력으로 바뀐다
+
+    // ---- 계측 (기록은 각 스레드, 수집은 collectDiagnostics) ----
+    infiray::StageStats stats_;
+    struct Counters {
+        uint64_t video = 0, temp = 0, videoOverwritten = 0, tempOverwritten = 0;
+        uint64_t outputDropped = 0, displayDropped = 0, encodeDropped = 0, encodedBytes = 0;
+        uint64_t recordDropped = 0, recordBytes = 0;
+        uint64_t renderSkipped = 0, unpaired = 0;
+        uint64_t videoCopyBytes = 0;
+    };
+    Counters lastCounters_;  // collectDiagnostics 전용
+
+    rclcpp::Publisher<ImageContainer>::SharedPtr image_pub_;
+    rclcpp::Publisher<std_msgs::msg::Float32>::SharedPtr temp_pub_;
+    rclcpp::Publisher<std_msgs::msg::Bool>::SharedPtr fire_pub_;
+    rclcpp::Publisher<std_msgs::msg::Float32>::SharedPtr fire_conf_pub_;
+    rclcpp::Publisher<ImageContainer>::SharedPtr fire_mask_pub_;
+    rclcpp::Publisher<ImageContainer>::SharedPtr raw_pub_;
+    rclcpp::Publisher<sensor_msgs::msg::CompressedImage>::SharedPtr compressed_pub_;
+    rclcpp::Publisher<infiray_ros2::msg::HotspotArray>::SharedPtr hotspots_pub_;
+    rclcpp::Publisher<infiray_ros2::msg::ThermalBlobArray>::SharedPtr blobs_pub_;
+    rclcpp::Publisher<infiray_ros2::msg::ThermalStatsArray>::SharedPtr stats_pub_;
+    rclcpp::Publisher<sensor_msgs::msg::CameraInfo>::SharedPtr info_pub_;
+};
+
+}  // namespace infiray_ros2
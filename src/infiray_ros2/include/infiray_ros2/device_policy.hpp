@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "infiray_ros2/temp_codec.hpp"
+
+namespace infiray {
+
+// ---- 장치 정책 (컴파일 타임) ----
+// 온도 버퍼 배치(decode), raw -> 섭씨 변환 법칙, raw 범위, 기본 해상도를 장치 종류마다 한 형(type)으로 묶는다.
+// 픽셀 루프는 정책을 템플릿 인자로 받아 장치마다 따로 컴파일되므로 루프 안에 장치 분기가 없다.
+// 새 카메라 모델은 같은 멤버를 가진 구조체 하나를 추가하면 된다.
+//
+//   kName                 로그/벤치마크용 이름
+//   kWidth, kHeight       기본 해상도 (실제 값은 콜백이 알려 준다)
+//   kRawLevels            raw 값 개수 (LUT 크기)
+//   pixelCount(bytes)     SDK 버퍼 바이트 수 -> 픽셀 수
+//   decode(buf, n, out)   SDK 버퍼 -> 픽셀 순서 uint16 raw
+//   toCelsius(raw)        변환 법칙 (LUT 생성과 검증용, 픽셀 루프에서는 celsiusTable 을 쓴다)
+//   toCentiCelsius(raw)   0.01 도 단위 정수 (텍스트 내보내기)
+//   fromCelsius(c)        역변환 (임계값을 raw 로 비교할 때)
+
+// InfraredTempSDK DeviceType 1 (B타입): 상/하위 바이트 평면, 구간별 공식, 14비트
+struct DeviceB {
+    static constexpr const char *kName = "infrared_temp_b";
+    static constexpr int kWidth = 640;
+    static constexpr int kHeight = 512;
+    static constexpr int kRawLevels = infiray::kRawLevels;
+
+    static constexpr size_t pixelCount(size_t bytes) { return bytes / 2; }
+    static void decode(const uint8_t *buf, size_t numPixels, uint16_t *out) { decodeTempB(buf, numPixels, out); }
+    static double toCelsius(double raw) { return rawToCelsius(raw); }
+    static int32_t toCentiCelsius(uint16_t raw) {
+        const double c = rawToCelsius(raw) * 100.0;
+        return (int32_t)(c < 0.0 ? c - 0.5 : c + 0.5);
+    }
+    static uint16_t fromCelsius(double celsius) { return celsiusToRaw(celsius); }
+};
+
+// IRCNetSDK (IRC_NET_StartPullTemp_V2): 픽셀 순서 리틀엔디언 uint16, 0.1 K 단위
+struct DeviceIrcNet {
+    static constexpr const char *kName = "ircnet_k10";
+    static constexpr int kWidth = 640;
+    static constexpr int kHeight = 512;
+    static constexpr int kRawLevels = 65536;
+
+    static constexpr size_t pixelCount(size_t bytes) { return bytes / 2; }
+    static void decode(const uint8_t *buf, size_t numPixels, uint16_t *out) {
+        std::memcpy(out, buf, numPixels * sizeof(uint16_t));
+    }
+    static double toCelsius(double raw) { return raw / 10.0 - 273.15; }
+    // raw / 10 - 273.15 는 0.01 도 단위로 정확히 떨어진다
+    static int32_t toCentiCelsius(uint16_t raw) { return (int32_t)raw * 10 - 27315; }
+    static uint16_t fromCelsius(double celsius) {
+        const double raw = (celsius + 273.15) * 10.0;
+        return raw <= 0.0 ? 0 : raw >= 65535.0 ? 65535 : (uint16_t)(raw + 0.5);
+    }
+};
+
+// 범위를 넘는 raw 는 최댓값으로 본다 (16비트 전 구간 장치는 비교가 컴파일 때 사라진다)
+template <typename Device>
+inline uint16_t clampDeviceRaw(uint16_t raw) {
+    return (int)raw < Device::kRawLevels ? raw : (uint16_t)(Device::kRawLevels - 1);
+}
+
+// ---- 장치별 raw -> 섭씨 LUT (최초 호출 시 한 번 생성) ----
+template <typename Device>
+const float *celsiusTable() {
+    static const float *table = [] {
+        auto *t = new float[Device::kRawLevels];
+        for (int r = 0; r < Device::kRawLevels; r++) t[r] = (float)Device::toCelsius(r);
+        return t;
+    }();
+    return table;
+}
+
+// B타입은 기존 celsiusLut() 를 그대로 쓴다 (같은 표를 두 번 만들지 않도록)
+template <>
+inline const float *celsiusTable<DeviceB>() {
+    return celsiusLut().celsius;
+}
+
+// ---- 디코딩 + 섭씨 변환 커널 ----
+template <typename Device>
+inline void rawToCelsiusFrame(const uint16_t *raw, size_t numPixels, float *celsius) {
+    const float *lut = celsiusTable<Device>();
+    for (size_t i = 0; i < numPixels; i++) celsius[i] = lut[clampDeviceRaw<Device>(raw[i])];
+}
+
+// SDK 버퍼 -> raw (항상) + 섭씨 (celsius 가 nullptr 이 아니면)
+template <typename Device>
+inline void decodeFrame(const uint8_t *buf, size_t numPixels, uint16_t *raw, float *celsius = nullptr) {
+    Device::decode(buf, numPixels, raw);
+    if (celsius != nullptr) rawToCelsiusFrame<Device>(raw, numPixels, celsius);
+}
+
+}  // namespace infiray
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace infiray {
+
+// ---- 화재 판정 설정 ----
+// 픽셀이 "뜨거움" 이 되는 조건 (하나라도):
+//   평활 온도 >= thresholdC, 기준선 대비 상승폭 >= riseDeltaC, 상승 속도 >= riseRateCps
+// 해제 조건 (모두): 평활 온도 < releaseC, 상승폭 < riseDeltaReleaseC, 상승 속도 < riseRateCps
+// 뜨거움이 onFrames 프레임 연속이면 화재 픽셀, 해제 조건이 offFrames 프레임 연속이면 정상으로 돌아간다.
+struct FireDetectorConfig {
+    double thresholdC = 80.0;         // 기존 celsius > 80 기준
+    double releaseC = 70.0;
+    double riseDeltaC = 15.0;         // 천천히 커지는 불 (절대 기준 아래)
+    double riseDeltaReleaseC = 8.0;
+    double riseRateCps = 5.0;         // 급격한 상승 (C/s)
+    double baselineTauS = 60.0;       // 기준선 EMA 시간 상수 (정상 픽셀만 따라감)
+    double smoothTauS = 0.3;          // 센서 노이즈 평활 EMA 시간 상수
+    int onFrames = 3;
+    int offFrames = 15;
+    int minPixels = 4;                // 이 개수 이상 화재 픽셀이면 detected
+};
+
+struct FireResult {
+    bool detected = false;
+    float confidence = 0.0f;  // 화재 픽셀 수 / minPixels (최대 1)
+    int firePixels = 0;
+    int hotPixels = 0;        // 아직 onFrames 를 채우지 못한 픽셀 포함, 이번 프레임 뜨거움
+};
+
+// ---- 픽셀 단위 시간 화재 검출기 ----
+// 상태는 픽셀마다 float 배열(평활 온도, 기준선, 연속 횟수, 화재 여부)로 두고
+// 분기 없는 select 로만 갱신해 컴파일러가 한 루프로 벡터화하게 한다.
+// 온도는 rawToKelvin30 정수식으로 바꾸므로 LUT gather 가 없다.
+class FireDetector {
+public:
+    explicit FireDetector(const FireDetectorConfig &cfg = FireDetectorConfig()) : cfg_(cfg) {}
+
+    // captureNs 는 프레임 간격(dt) 계산용. 해상도가 바뀌면 상태를 새로 시작한다.
+    const FireResult &update(const uint16_t *temp, int width, int height, uint64_t captureNs);
+    void reset() { width_ = height_ = 0; }
+
+    // 화재 픽셀 마스크 (0 / 255, width x height)
+    const uint8_t *mask() const { return mask_.data(); }
+    const FireResult &result() const { return result_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+private:
+    FireDetectorConfig cfg_;
+    int width_ = 0;
+    int height_ = 0;
+    uint64_t lastNs_ = 0;
+    std::vector<float> smooth_;    // 평활 온도 (C)
+    std::vector<float> baseline_;  // 기준선 (C)
+    std::vector<float> count_;     // 현재 상태를 뒤집는 조건의 연속 프레임 수
+    std::vector<float> fire_;      // 0 / 1
+    std::vector<uint8_t> mask_;
+    FireResult result_;
+};
+
+}  // namespace infiray
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+namespace infiray {
+
+// ---- 녹화 파일 포맷 (.irrec) ----
+// [FileHeader][RecordHeader][video bytes][temp bytes][RecordHeader]...
+// 영상/온도 콜백이 따로 들어오므로 레코드 하나에는 둘 중 하나만 있어도 된다.
+
+constexpr char kRecordFileMagic[8] = {'I', 'R', 'R', 'E', 'C', '0', '1', '\0'};
+constexpr uint32_t kRecordMagic = 0x31435249;  // "IRC1"
+constexpr uint32_t kRecordVersion = 1;
+
+enum VideoFormat : uint16_t {
+    kVideoNone   = 0,
+    kVideoYuv420 = 1,  // SDK 가 넘겨주는 I420 전체 (w*h*3/2)
+    kVideoYOnly  = 2,  // Y 평면만 (w*h)
+};
+
+enum TempFormat : uint16_t {
+    kTempNone        = 0,
+    kTempSdkB        = 1,  // SDK 원본 (B타입 비트 교차 배열, w*h*2)
+    kTempDecodedU16  = 2,  // 디코딩 완료된 row-major uint16 (w*h*2)
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t reserved;
+};
+static_assert(sizeof(FileHeader) == 24, "FileHeader layout");
+
+struct RecordHeader {
+    uint32_t magic;
+    uint16_t videoFormat;
+    uint16_t tempFormat;
+    uint64_t captureNs;   // steady clock 기준 캡처 시각
+    uint32_t width;
+    uint32_t height;
+    uint32_t videoBytes;
+    uint32_t tempBytes;
+};
+static_assert(sizeof(RecordHeader) == 32, "RecordHeader layout");
+
+// ---- 프레임 색인 (<세그먼트>.idx) ----
+// [IndexFileHeader][RecordIndexEntry] * count
+// 레코드 위치를 바로 찾을 수 있게 세그먼트를 닫을 때 쓴다. 없으면 레코드를 처음부터 훑으면 된다.
+constexpr char kIndexFileMagic[8] = {'I', 'R', 'I', 'D', 'X', '0', '1', '\0'};
+
+struct IndexFileHeader {
+    char magic[8];
+    uint64_t count;
+};
+static_assert(sizeof(IndexFileHeader) == 16, "IndexFileHeader layout");
+
+struct RecordIndexEntry {
+    uint64_t captureNs;
+    uint64_t offset;       // 세그먼트 파일 안에서 RecordHeader 위치
+    uint32_t recordBytes;  // 헤더 포함
+    uint16_t videoFormat;
+    uint16_t tempFormat;
+};
+static_assert(sizeof(RecordIndexEntry) == 24, "RecordIndexEntry layout");
+
+}  // namespace infiray
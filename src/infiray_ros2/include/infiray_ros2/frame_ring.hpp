@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace infiray {
+
+// ---- 프레임 버퍼 할당자 ----
+// 64 바이트(캐시 라인) 정렬, 할당 횟수/바이트 집계 (soak 테스트에서 콜백 경로 할당이 없는지 확인용).
+// resize 로 늘린 원소를 0 으로 채우지 않으므로 (기본 초기화) 곧 덮어쓸 프레임에 쓰기 패스가 한 번 줄어든다.
+struct FrameAllocStats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+inline std::atomic<uint64_t> g_frameAllocations{0};
+inline std::atomic<uint64_t> g_frameAllocBytes{0};
+
+inline FrameAllocStats frameAllocStats() {
+    return {g_frameAllocations.load(std::memory_order_relaxed), g_frameAllocBytes.load(std::memory_order_relaxed)};
+}
+
+template <typename T>
+struct FrameAllocator {
+    using value_type = T;
+    static constexpr size_t kAlign = 64;
+
+    FrameAllocator() = default;
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U> &) noexcept {}
+
+    T *allocate(size_t n) {
+        g_frameAllocations.fetch_add(1, std::memory_order_relaxed);
+        g_frameAllocBytes.fetch_add(n * sizeof(T), std::memory_order_relaxed);
+        return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(kAlign)));
+    }
+    void deallocate(T *p, size_t) noexcept { ::operator delete(p, std::align_val_t(kAlign)); }
+
+    // 값 초기화 대신 기본 초기화 (uint8_t/uint16_t 는 아무것도 쓰지 않는다)
+    template <typename U>
+    void construct(U *p) noexcept {
+        ::new ((void *)p) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U *p, Args &&...args) {
+        ::new ((void *)p) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U> &) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const FrameAllocator<U> &) const noexcept { return false; }
+};
+
+template <typename T>
+using FrameBuffer = std::vector<T, FrameAllocator<T>>;
+
+// ---- 프레임 슬롯 ----
+template <typename T>
+struct FrameSlot {
+    uint64_t seq = 0;        // 생산자가 붙이는 일련번호 (1부터)
+    uint64_t captureNs = 0;  // steady clock 기준 캡처 시각
+    int width = 0;
+    int height = 0;
+    FrameBuffer<T> data;
+};
+
+// ---- 단일 생산자/단일 소비자 최신 프레임 링 ----
+// 미리 할당한 3개 슬롯을 생산자(back), 게시(ready), 소비자(front)가 하나씩 소유한다.
+// publish/acquireLatest 는 atomic exchange 한 번뿐이라 어느 쪽도 기다리지 않으며,
+// 소비자가 가져가기 전에 덮어쓴 프레임은 overwritten() 으로 집계된다.
+template <typename T>
+class FrameRing {
+public:
+    explicit FrameRing(size_t reserveElems = 0) {
+        for (auto &s : slots_) s.data.reserve(reserveElems);
+    }
+
+    FrameRing(const FrameRing &) = delete;
+    FrameRing &operator=(const FrameRing &) = delete;
+
+    // 슬롯 용량을 elems 로 늘린다 (스트림 시작 전, 생산자가 돌기 전에만 부른다)
+    void reserve(size_t elems) {
+        for (auto &s : slots_) s.data.reserve(elems);
+    }
+
+    // 예약한 용량을 한 번 써서 페이지를 미리 받아 둔다 (mlockall 과 함께 쓰면 첫 프레임부터 페이지 폴트 없음).
+    // 생산자가 돌기 전에만 부른다.
+    void prefault() {
+        for (auto &s : slots_) {
+            const size_t n = s.data.size();
+            s.data.resize(s.data.capacity());  // 기본 초기화라 resize 만으로는 페이지를 건드리지 않는다
+            if (!s.data.empty()) std::memset((void *)s.data.data(), 0, s.data.size() * sizeof(T));
+            s.data.resize(n);  // 줄일 때는 해제하지 않는다
+        }
+    }
+
+    // ---- 생산자 ----
+    // 현재 쓰기 슬롯. 예약 용량 안이면 할당도 0 채우기도 없다. 넘으면 (해상도가 예약보다 클 때) 재할당하고 센다.
+    FrameSlot<T> &writeSlot(size_t elems) {
+        FrameSlot<T> &s = slots_[back_];
+        if (elems > s.data.capacity()) grown_.fetch_add(1, std::memory_order_relaxed);
+        if (s.data.size() != elems) s.data.resize(elems);
+        return s;
+    }
+
+    void publish() {
+        slots_[back_].seq = ++seq_;
+        const uint32_t prev = ready_.exchange(back_ | kDirty, std::memory_order_acq_rel);
+        if (prev & kDirty) overwritten_.fetch_add(1, std::memory_order_relaxed);
+        back_ = prev & kIndexMask;
+        published_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ---- 소비자 ----
+    bool hasNew() const { return (ready_.load(std::memory_order_acquire) & kDirty) != 0; }
+
+    // 아직 보지 않은 최신 프레임. 없으면 nullptr.
+    // 반환된 슬롯은 다음 acquireLatest 호출 전까지 소비자 소유이다.
+    const FrameSlot<T> *acquireLatest() {
+        if (!hasNew()) return nullptr;
+        const uint32_t prev = ready_.exchange(front_, std::memory_order_acq_rel);
+        front_ = prev & kIndexMask;
+        return &slots_[front_];
+    }
+
+    // acquireLatest 와 같지만 슬롯 버퍼를 복사 없이 바꿔 낄 수 있다 (이력 보관용).
+    // 바꿔 넣은 버퍼는 나중에 생산자가 쓰므로 같은 용량을 예약해 둔 버퍼여야 재할당이 없다.
+    FrameSlot<T> *acquireLatestMutable() {
+        if (acquireLatest() == nullptr) return nullptr;
+        return &slots_[front_];
+    }
+
+    // 마지막으로 가져간 슬롯 (한 번도 없으면 seq == 0)
+    const FrameSlot<T> &current() const { return slots_[front_]; }
+
+    uint64_t published() const { return published_.load(std::memory_order_relaxed); }
+    uint64_t overwritten() const { return overwritten_.load(std::memory_order_relaxed); }
+    // 생산자 쪽에서 예약 용량을 넘어 재할당한 횟수 (0 이어야 콜백 경로에 할당이 없다)
+    uint64_t grown() const { return grown_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32_t kIndexMask = 0x3;
+    static constexpr uint32_t kDirty = 0x4;
+
+    FrameSlot<T> slots_[3];
+    uint32_t back_ = 0;                    // 생산자 전용
+    uint32_t front_ = 2;                   // 소비자 전용
+    uint64_t seq_ = 0;                     // 생산자 전용
+    alignas(64) std::atomic<uint32_t> ready_{1};
+    alignas(64) std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> overwritten_{0};
+    std::atomic<uint64_t> grown_{0};
+};
+
+}  // namespace infiray
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace infiray {
+
+// InfraredTempSDK 콜백과 같은 시그니처. 모든 소스가 동일한 콜백 경로를 구동한다.
+using VideoCallbackFn = void (*)(char *pBuffer, long BufferLen, int width, int height, void *pContext);
+using TempCallbackFn  = void (*)(char *pBuffer, long BufferLen, void *pContext);
+// 재생/합성 소스가 마지막 프레임을 보낸 뒤 한 번 (소비자가 폴링 없이 종료를 알 수 있도록)
+using EndCallbackFn   = void (*)(void *pContext);
+
+// ---- 프레임 소스 인터페이스 ----
+class FrameSource {
+public:
+    virtual ~FrameSource() = default;
+
+    void setCallbacks(VideoCallbackFn video, TempCallbackFn temp, void *context, EndCallbackFn end = nullptr) {
+        videoCb_ = video;
+        tempCb_ = temp;
+        endCb_ = end;
+        context_ = context;
+    }
+
+    virtual bool start() = 0;
+    virtual void stop() = 0;
+    virtual const char *name() const = 0;
+    // 재생/합성 소스가 더 보낼 프레임이 없을 때 true
+    bool finished() const { return finished_.load(std::memory_order_acquire); }
+
+protected:
+    void markFinished() {
+        finished_.store(true, std::memory_order_release);
+        if (endCb_) endCb_(context_);
+    }
+
+    VideoCallbackFn videoCb_ = nullptr;
+    TempCallbackFn tempCb_ = nullptr;
+    EndCallbackFn endCb_ = nullptr;
+    void *context_ = nullptr;
+    std::atomic<bool> finished_{false};
+};
+
+// ---- 실제 카메라 (InfiRay SDK) ----
+struct SdkSourceConfig {
+    int deviceType = 1;
+    std::string ip = "192.168.1.123";
+    int port = 3000;
+    std::string username = "admin";
+    std::string password = "admin";
+};
+
+// INFIRAY_WITH_SDK 가 꺼진 빌드에서는 nullptr 를 돌려준다.
+std::unique_ptr<FrameSource> makeSdkFrameSource(const SdkSourceConfig &cfg);
+
+// ---- 합성 프레임 (움직이는 고온 영역) ----
+struct SyntheticSourceConfig {
+    int width = 640;
+    int height = 512;
+    double fps = 30.0;        // 0 이하이면 제한 없이 최대 속도
+    int numBlobs = 3;
+    double ambientC = 25.0;
+    double blobPeakC = 350.0;
+    int blobRadius = 24;
+    uint32_t seed = 1;
+    long maxFrames = 0;       // 0 이면 무한
+};
+
+class SyntheticFrameSource : public FrameSource {
+public:
+    explicit SyntheticFrameSource(const SyntheticSourceConfig &cfg);
+    ~SyntheticFrameSource() override;
+
+    bool start() override;
+    void stop() override;
+    const char *name() const override { return "synthetic"; }
+
+    // 스레드 없이 한 프레임만 생성 (벤치마크용)
+    void renderFrame(long frameIndex);
+    const std::vector<uint16_t> &tempFrame() const { return temp_; }
+    const std::vector<uint8_t> &yuvFrame() const { return yuv_; }
+    const std::vector<uint8_t> &sdkTempFrame() const { return sdkTemp_; }
+
+private:
+    struct Blob { double x, y, vx, vy, peakC; };
+
+    void run();
+
+    SyntheticSourceConfig cfg_;
+    std::vector<Blob> blobs_;
+    std::vector<uint16_t> temp_;
+    std::vector<uint8_t> sdkTemp_;
+    std::vector<uint8_t> yuv_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+};
+
+// ---- 녹화 파일 재생 (.irrec) ----
+struct ReplaySourceConfig {
+    std::string path;      // .irrec 파일 또는 MmapRecorder 에 준 경로 (세그먼트를 번호 순으로 이어 재생)
+    bool realtime = true;  // false 이면 기록된 간격을 무시하고 최대 속도
+    bool loop = false;
+};
+
+class ReplayFrameSource : public FrameSource {
+public:
+    explicit ReplayFrameSource(const ReplaySourceConfig &cfg);
+    ~ReplayFrameSource() override;
+
+    bool start() override;
+    void stop() override;
+    const char *name() const override { return "replay"; }
+
+private:
+    void run();
+
+    ReplaySourceConfig cfg_;
+    std::vector<std::string> files_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+};
+
+}  // namespace infiray
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace infiray {
+
+// ---- 관심 영역 (다각형, 픽셀 좌표) ----
+struct StatsRoi {
+    std::string name;
+    std::vector<float> xy;  // x0, y0, x1, y1, ... (3 꼭짓점 이상, 짝홀 규칙)
+};
+
+// ---- 영역 하나의 온도 통계 ----
+struct RegionStats {
+    uint32_t pixels = 0;
+    float minCelsius = 0.0f;
+    float maxCelsius = 0.0f;
+    float meanCelsius = 0.0f;
+    std::vector<float> percentileCelsius;  // FrameStatsEngine::percentiles() 순서
+};
+
+// ---- 프레임 전체 + 다각형 ROI 통계 (한 번의 순회) ----
+// 다각형은 해상도가 바뀔 때만 행 단위 run (y, x0, x1, roi) 으로 미리 래스터화한다.
+// 온도 맵은 행 순서로 한 번만 읽고, 한 행을 읽은 김에 그 행의 ROI run 을 모두 처리하므로
+// ROI 를 늘려도 추가 비용은 ROI 면적만큼의 히스토그램 증가뿐이다.
+// 히스토그램은 14비트 raw 를 1/30 K 눈금(rawToKelvin30) 칸으로 옮겨 쌓는다.
+// raw 순서는 구간 경계(7300)에서 온도 순서와 다르므로 온도 순서인 칸이어야 분위수가 맞다.
+// 요약 때 [최소, 최대] 칸만 훑고 그 자리에서 0 으로 되돌리므로 프레임마다 전체를 지우지 않는다.
+class FrameStatsEngine {
+public:
+    FrameStatsEngine();
+
+    // percentiles 는 0~100 (예: 50, 90, 99), 오름차순으로 정렬해 둔다
+    void configure(const std::vector<StatsRoi> &rois, const std::vector<double> &percentiles);
+
+    void update(const uint16_t *temp, int width, int height);
+
+    const RegionStats &frame() const { return frame_; }
+    const std::vector<RegionStats> &rois() const { return roiStats_; }
+    const std::vector<StatsRoi> &roiDefs() const { return rois_; }
+    const std::vector<double> &percentiles() const { return percentiles_; }
+    // 래스터화된 run 수 (해상도가 정해진 뒤)
+    size_t runCount() const { return segs_.size(); }
+
+private:
+    struct Segment {
+        int x0, x1;  // x1 제외
+        int roi;
+    };
+    struct Acc {
+        uint32_t pixels = 0;
+        uint16_t lo = 0xFFFF, hi = 0;
+    };
+
+    void rasterize(int width, int height);
+    void summarize(uint32_t *hist, const Acc &acc, RegionStats &out);
+
+    std::vector<StatsRoi> rois_;
+    std::vector<double> percentiles_;
+    int width_ = 0, height_ = 0;
+
+    std::vector<uint16_t> binOf_;     // raw(14비트) -> 칸
+    std::vector<Segment> segs_;       // 행 순서
+    std::vector<int> rowStart_;       // 행 y 의 run 은 segs_[rowStart_[y] .. rowStart_[y+1])
+    std::vector<uint32_t> frameHist_;
+    std::vector<uint32_t> roiHist_;   // ROI 마다 kBins 칸
+    std::vector<Acc> roiAcc_;
+    RegionStats frame_;
+    std::vector<RegionStats> roiStats_;
+    std::vector<float> crossings_;
+    std::vector<uint64_t> ranks_;
+};
+
+}  // namespace infiray
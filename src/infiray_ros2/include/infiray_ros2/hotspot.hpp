@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace infiray {
+
+// ---- 최고 온도 영역 ----
+struct Hotspot {
+    bool valid = false;
+    int x = 0, y = 0;       // 창 좌상단 (프레임 안쪽으로 고정)
+    int w = 0, h = 0;
+    double celsius = 0.0;   // 창 안 픽셀 섭씨 평균
+};
+
+// ---- 적분 영상(summed-area table) 기반 고온 영역 엔진 ----
+// build() 로 프레임당 한 번 적분 영상을 만들면, 창 크기가 여러 개여도 같은 표에서 O(1)/위치로 답한다.
+// 값은 1/30 K 정수(rawToKelvin30)로 누적하며 uint32 로 감싸 돌아가게 둔다.
+// 창 합이 2^32 미만이면 네 모서리 차는 정확하므로 창 넓이만 kMaxWindowArea 로 제한한다.
+class HotspotEngine {
+public:
+    // 픽셀당 최대 26166 (clampRaw 한 14비트 raw) -> 2^32 / 26166 ≈ 164000 (약 400x400)
+    static constexpr long kMaxWindowArea = 160000;
+
+    void build(const uint16_t *temp, int width, int height);
+
+    // 서로 겹치지 않는 상위 k 개 창을 뜨거운 순으로 out 에 채우고 개수를 돌려준다.
+    int topK(int winW, int winH, int k, Hotspot *out);
+
+    // 임의 창의 평균 섭씨
+    double meanCelsius(int x, int y, int w, int h) const;
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+private:
+    uint32_t boxSum(int x, int y, int w, int h) const {
+        const size_t stride = (size_t)width_ + 1;
+        const uint32_t *top = &sat_[(size_t)y * stride + x];
+        const uint32_t *bot = &sat_[(size_t)(y + h) * stride + x];
+        return bot[w] - bot[0] - top[w] + top[0];
+    }
+
+    int width_ = 0;
+    int height_ = 0;
+    std::vector<uint32_t> sat_;      // (H+1) x (W+1), 프레임 간 재사용
+    std::vector<uint32_t> windows_;  // 창 크기별 합 맵, 재사용
+    std::vector<uint32_t> rowMax_;
+};
+
+}  // namespace infiray
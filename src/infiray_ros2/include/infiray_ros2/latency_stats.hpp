@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace infiray {
+
+inline uint64_t steadyNowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ---- 구간 통계 (takeInterval 한 번 분량) ----
+struct LatencySummary {
+    uint64_t count = 0;
+    uint64_t p50Ns = 0;
+    uint64_t p90Ns = 0;
+    uint64_t p99Ns = 0;
+    uint64_t maxNs = 0;
+    double meanNs = 0.0;
+};
+
+// ---- HDR 방식 지연 히스토그램 ----
+// 2의 거듭제곱 구간마다 8칸 (상대 오차 12.5% 이하), 1 ns ~ 약 2^40 ns 범위.
+// record 는 relaxed fetch_add 몇 번뿐이라 콜백/처리 스레드 어디서든 잠금 없이 부른다.
+// takeInterval 은 칸을 0 으로 교환하며 읽으므로 동시에 기록된 값은 다음 구간으로 넘어간다.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBits = 3;
+    static constexpr int kSubCount = 1 << kSubBits;
+    static constexpr int kBuckets = 320;
+
+    void record(uint64_t ns) {
+        counts_[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t cur = max_.load(std::memory_order_relaxed);
+        while (ns > cur && !max_.compare_exchange_weak(cur, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencySummary takeInterval();
+
+    static int bucketOf(uint64_t ns) {
+        if (ns < (uint64_t)kSubCount) return (int)ns;
+        const int e = 63 - __builtin_clzll(ns);
+        const int idx = (e - kSubBits + 1) * kSubCount + (int)((ns >> (e - kSubBits)) & (kSubCount - 1));
+        return idx < kBuckets ? idx : kBuckets - 1;
+    }
+
+    // 칸의 대표값 (칸 가운데)
+    static uint64_t bucketValue(int idx) {
+        if (idx < kSubCount) return (uint64_t)idx;
+        const int e = idx / kSubCount + kSubBits - 1;
+        const uint64_t sub = (uint64_t)(idx % kSubCount);
+        const uint64_t lower = (kSubCount + sub) << (e - kSubBits);
+        const uint64_t width = 1ull << (e - kSubBits);
+        return lower + width / 2;
+    }
+
+private:
+    std::atomic<uint64_t> counts_[kBuckets] = {};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> max_{0};
+};
+
+// ---- 파이프라인 단계 ----
+enum class Stage : int {
+    kCallbackCopy,    // 영상 콜백 -> 링 복사
+    kDecode,          // 온도 콜백 B타입 디코딩
+    kHotspot,         // 적분 영상 + 상위 K 창
+    kFire,            // 픽셀 단위 화재 상태 갱신
+    kBlobs,           // 고온 덩어리 분할 + 추적
+    kStats,           // 전체/ROI 온도 통계
+    kRender,          // 오버레이 렌더
+    kEncode,          // 오버레이 JPEG/PNG 압축
+    kSerialize,       // 발행 메시지 구성 (ImageContainer / CameraInfo)
+    kPublish,         // publish() 호출
+    kCaptureToAlarm,  // 온도 캡처 -> max_temp/fire 발행 완료
+    kCaptureToImage,  // 영상 캡처 -> 오버레이 발행 완료
+    kPairOffset,      // 영상과 짝지은 온도 프레임의 캡처 시각 차이 (지연이 아니라 |차이|)
+    kCount
+};
+
+const char *stageName(Stage stage);
+
+class StageStats {
+public:
+    void record(Stage stage, uint64_t ns) { hist_[(int)stage].record(ns); }
+    LatencySummary takeInterval(Stage stage) { return hist_[(int)stage].takeInterval(); }
+
+private:
+    LatencyHistogram hist_[(int)Stage::kCount];
+};
+
+}  // namespace infiray
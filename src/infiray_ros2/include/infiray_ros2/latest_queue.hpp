@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace infiray {
+
+// ---- 파이프라인 단계 사이의 크기 제한 큐 (latest-wins) ----
+// 가득 찬 상태에서 push 하면 가장 오래된 항목을 버리므로 생산자는 절대 기다리지 않는다.
+// 느린 소비자(발행/화면)는 최신 항목만 받고, 버린 개수는 dropped() 로 집계된다.
+template <typename T>
+class LatestQueue {
+public:
+    explicit LatestQueue(size_t capacity = 1) : capacity_(std::max<size_t>(1, capacity)) {}
+
+    LatestQueue(const LatestQueue &) = delete;
+    LatestQueue &operator=(const LatestQueue &) = delete;
+
+    void setCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lk(mtx_);
+        capacity_ = std::max<size_t>(1, capacity);
+    }
+
+    // 닫힌 뒤의 push 는 무시한다
+    void push(T item) {
+        T victim;  // 버리는 항목의 해제(버퍼 참조 반납)는 잠금 밖에서
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (closed_) return;
+            if (items_.size() >= capacity_) {
+                victim = std::move(items_.front());
+                items_.pop_front();
+                dropped_++;
+            }
+            items_.push_back(std::move(item));
+            pushed_++;
+        }
+        cv_.notify_one();
+    }
+
+    // 항목이 올 때까지 기다린다. 닫혔고 비어 있으면 false.
+    bool pop(T &out) {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait(lk, [this] { return !items_.empty() || closed_; });
+        return takeFront(out);
+    }
+
+    // timeout 안에 항목이 없거나 닫혔으면 false (GUI 이벤트 처리처럼 주기적으로 깨어나야 할 때)
+    template <typename Rep, typename Period>
+    bool popFor(T &out, std::chrono::duration<Rep, Period> timeout) {
+        std::unique_lock<std::mutex> lk(mtx_);
+        cv_.wait_for(lk, timeout, [this] { return !items_.empty() || closed_; });
+        return takeFront(out);
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            closed_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    bool closed() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return closed_;
+    }
+
+    uint64_t pushed() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return pushed_;
+    }
+
+    uint64_t dropped() const {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return dropped_;
+    }
+
+private:
+    bool takeFront(T &out) {
+        if (items_.empty()) return false;
+        out = std::move(items_.front());
+        items_.pop_front();
+        return true;
+    }
+
+    mutable std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<T> items_;
+    size_t capacity_;
+    bool closed_ = false;
+    uint64_t pushed_ = 0;
+    uint64_t dropped_ = 0;
+};
+
+}  // namespace infiray
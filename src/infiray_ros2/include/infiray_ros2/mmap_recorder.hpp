@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "infiray_ros2/frame_record.hpp"
+
+namespace infiray {
+
+// ---- mmap 녹화 설정 ----
+struct MmapRecorderConfig {
+    std::string path;                     // "run.irrec" -> run_0000.irrec, run_0001.irrec ...
+    uint64_t segmentBytes = 1ull << 30;   // 세그먼트 하나의 선할당 크기
+    int maxSegments = 0;                  // 0 이면 무제한, 넘으면 가장 오래된 세그먼트부터 지운다
+    size_t queueBytes = 64u << 20;        // 콜백 -> 기록 스레드 사이 버퍼 총량 (넘치면 프레임을 버림)
+    size_t recordBytes = 4u << 20;        // 레코드 하나(헤더 포함)의 최대 크기. 큐 블록 하나의 크기다.
+    size_t writebackBytes = 16u << 20;    // 이만큼 쓸 때마다 디스크로 내보내고 페이지 캐시에서 내린다
+};
+
+// ---- 세그먼트 단위 mmap 녹화기 ----
+// 세그먼트 파일을 segmentBytes 만큼 미리 잡아 mmap 하고, 기록 스레드가 레코드를 memcpy 로 붙인다.
+// 세그먼트 하나하나가 그대로 .irrec 파일이며, 닫을 때 실제 길이로 자르고 프레임 색인(.idx)을 쓴다.
+// 비정상 종료로 잘리지 못해도 남은 영역은 0 이라 재생은 마지막 온전한 레코드에서 멈춘다.
+//
+// append 는 SDK 콜백에서 불러도 되며 기다리지도 할당하지도 않는다. 큐 블록(recordBytes 짜리
+// queueBytes / recordBytes 개)과 대기 링은 open() 에서 모두 잡아 두고, 빈 블록이 없거나
+// 레코드가 recordBytes 보다 크면 그 프레임을 버리고 dropped() 로 센다.
+// 다 쓴 구간은 writebackBytes 마다 내보낸 뒤 캐시에서 내리므로 긴 녹화에도 메모리가 늘지 않는다.
+class MmapRecorder {
+public:
+    MmapRecorder() = default;
+    ~MmapRecorder() { close(); }
+    MmapRecorder(const MmapRecorder &) = delete;
+    MmapRecorder &operator=(const MmapRecorder &) = delete;
+
+    // 첫 세그먼트까지 열고 기록 스레드를 띄운다
+    bool open(const MmapRecorderConfig &cfg);
+    // 큐에 남은 프레임까지 쓰고 닫는다
+    void close();
+    bool isOpen() const { return open_.load(std::memory_order_acquire); }
+
+    // hdr 의 videoBytes / tempBytes 만큼 복사해 큐에 넣는다 (magic 은 여기서 채운다)
+    bool append(const RecordHeader &hdr, const void *video, const void *temp);
+
+    uint64_t recorded() const { return recorded_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t bytesWritten() const { return bytesWritten_.load(std::memory_order_relaxed); }
+    int segments() const { return segments_.load(std::memory_order_relaxed); }
+
+    // "run.irrec", 3 -> "run_0003.irrec"
+    static std::string segmentPath(const std::string &base, int index);
+
+private:
+    void run();
+    bool openSegment();
+    void closeSegment();
+    void writeBlock(const uint8_t *data, size_t n);
+    void writeback();
+
+    MmapRecorderConfig cfg_;
+    std::atomic<bool> open_{false};
+    std::thread thread_;
+
+    // ---- 콜백/기록 스레드 공유 (mtx_) ----
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    // 블록 번호만 오간다. 두 목록 모두 용량이 블록 수라 push 해도 재할당이 없다.
+    struct Block {
+        std::vector<uint8_t> data;  // recordBytes (open 에서 채워 페이지까지 잡아 둔다)
+        size_t size = 0;            // 채운 바이트
+    };
+    std::vector<Block> blocks_;
+    std::vector<uint32_t> free_;     // 빈 블록 스택
+    std::vector<uint32_t> pending_;  // 기록 대기 링 (pendingHead_ 부터 pendingCount_ 개)
+    size_t pendingHead_ = 0;
+    size_t pendingCount_ = 0;
+    bool closing_ = false;
+
+    // ---- 기록 스레드 전용 ----
+    std::string segPath_;
+    int fd_ = -1;
+    uint8_t *map_ = nullptr;
+    uint64_t offset_ = 0;      // 다음 레코드 위치
+    uint64_t flushedTo_ = 0;   // 여기까지 내보내기 시작함 (페이지 경계)
+    uint64_t droppedTo_ = 0;   // 여기까지 기록 완료 후 캐시에서 내림
+    int nextSegment_ = 0;
+    bool failed_ = false;      // 세그먼트를 못 열면 이후 프레임은 버린다
+    std::vector<RecordIndexEntry> index_;
+    size_t pageSize_ = 4096;
+
+    std::atomic<uint64_t> recorded_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> bytesWritten_{0};
+    std::atomic<int> segments_{0};
+};
+
+// base 로 녹화한 세그먼트 목록 (번호 순). base 가 파일 하나면 그것만 돌려준다.
+std::vector<std::string> listRecordSegments(const std::string &base);
+
+}  // namespace infiray
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace infiray {
+
+// ---- 팔레트 LUT ----
+// 항목은 B | G << 8 | R << 16 (little-endian 으로 메모리에 B, G, R 순서).
+// 4 픽셀을 uint32 3개로 모아 쓰므로 BGR 한 바이트씩 쓰는 것보다 저장이 적다.
+struct Palette8 {
+    uint32_t bgr[256] = {};
+};
+
+// 14비트 raw -> BGR. 온도 범위를 고정해 만든 표라 프레임마다 AGC 로 색이 바뀌지 않는다.
+struct PaletteRaw {
+    std::vector<uint32_t> bgr;  // levels 개 (B타입 16384)
+    float minC = 0.0f, maxC = 0.0f;
+};
+
+inline uint32_t packBgr(uint8_t b, uint8_t g, uint8_t r) { return (uint32_t)b | (uint32_t)g << 8 | (uint32_t)r << 16; }
+
+// 회색 (GRAY2BGR 과 같은 결과)
+Palette8 grayPalette();
+// 256 x BGR 바이트 (예: 0..255 램프에 cv::applyColorMap 을 적용한 결과) 에서
+Palette8 paletteFromBgr(const uint8_t *bgr);
+
+// celsius[raw] 로 온도를 구해 [minC, maxC] 를 팔레트 0..255 에 펼친다 (범위 밖은 양 끝 색)
+void buildRawPalette(const Palette8 &palette, const float *celsius, int levels, float minC, float maxC,
+                     PaletteRaw &out);
+
+// ---- 팔레트 + 마스크 합성 커널 (프레임당 메모리 한 번 통과) ----
+// 입력 한 번 읽기 -> 팔레트 색 (mask 가 0 이 아닌 픽셀은 maskBgr) -> dst 한 번 쓰기.
+// 예전 cvtColor/applyColorMap + setTo(mask) 의 두 패스를 하나로 합친다.
+// mask 가 nullptr 이면 팔레트만. dst 는 width * 3 바이트 이상 행, src/mask/dst 는 각자 행 간격(바이트).
+void renderPalette8(const uint8_t *src, size_t srcStride, int width, int height, const Palette8 &palette,
+                    const uint8_t *mask, size_t maskStride, uint32_t maskBgr, uint8_t *dst, size_t dstStride);
+
+// 14비트 raw 입력 (levels 이상 값은 마지막 색)
+void renderPaletteRaw(const uint16_t *src, size_t srcStride, int width, int height, const PaletteRaw &palette,
+                      const uint8_t *mask, size_t maskStride, uint32_t maskBgr, uint8_t *dst, size_t dstStride);
+
+}  // namespace infiray
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+
+namespace infiray {
+
+// ---- 스레드별 실시간 설정 (CPU 고정 + SCHED_FIFO) ----
+// 공유 SBC 에서 다른 노드가 캡처 -> 경보 경로를 선점하지 않도록 한다.
+// 권한이 없으면 (CAP_SYS_NICE / limits.conf rtprio) 실패를 보고만 하고 기본 스케줄링으로 계속 돈다.
+struct ThreadTuning {
+    std::vector<int> cpus;  // 비어 있으면 고정하지 않는다
+    int fifoPriority = 0;   // 1~99 이면 SCHED_FIFO, 0 이면 그대로
+
+    bool empty() const { return cpus.empty() && fifoPriority <= 0; }
+};
+
+// 적용 결과를 "cpus 2,3 ok, SCHED_FIFO 80 failed (...)" 처럼 돌려준다. 모두 성공하면 true.
+bool applyThreadTuning(pthread_t thread, const ThreadTuning &tuning, std::string &report);
+
+// mlockall (이후 할당도 첫 접근 때 잠근다). 결과를 report 로.
+bool lockProcessMemory(std::string &report);
+
+}  // namespace infiray
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace infiray {
+
+// ---- 같은 호스트 소비자용 공유 메모리 프레임 링 ----
+// POSIX shm 객체 하나가 스트림 하나 (/dev/shm/<name>). 쓰는 쪽은 노드 하나, 읽는 쪽은 여럿.
+//
+// [ShmRingHeader 128B][slot 0][slot 1]...   slot = [ShmSlotHeader 64B][payload, 64B 정렬]
+// 프레임 seq 는 1부터 늘고 슬롯은 (seq - 1) % slotCount 이다.
+// 슬롯마다 seqlock: 쓰는 동안 lock 이 홀수, 끝나면 짝수. 읽는 쪽은 읽기 전후 lock 이 같고 짝수면 온전한 프레임이다.
+// 해상도가 커져 슬롯이 모자라면 쓰는 쪽이 헤더에 stale 을 세우고 새 객체를 만든다 (읽는 쪽은 다시 연다).
+// 읽는 쪽은 읽기 전용으로 매핑하므로 쓰는 쪽은 프레임마다 futexWord 를 올리고 무조건 깨운다.
+// 파이썬 등 다른 언어 리더는 아래 오프셋을 그대로 따르면 된다 (little-endian).
+
+constexpr char kShmMagic[8] = {'I', 'R', 'S', 'H', 'M', '0', '1', '\0'};
+constexpr uint32_t kShmVersion = 1;
+
+enum ShmFormat : uint32_t {
+    kShmNone     = 0,
+    kShmTempRaw  = 1,  // uint16 raw (rawToCelsius 로 섭씨 변환)
+    kShmBgr8     = 2,
+    kShmMono8    = 3,
+};
+
+struct ShmRingHeader {
+    char magic[8];                      //  0
+    uint32_t version;                   //  8
+    uint32_t slotCount;                 // 12
+    uint64_t slotBytes;                 // 16 슬롯 payload 용량
+    uint64_t slotStride;                // 24 슬롯 헤더 + payload
+    uint64_t dataOffset;                // 32 slot 0 위치
+    std::atomic<uint32_t> stale;        // 40 1 이면 이 객체는 버려졌으니 다시 열 것
+    std::atomic<uint32_t> futexWord;    // 44 프레임마다 증가 (대기 중인 리더 깨우기)
+    std::atomic<uint64_t> latest;       // 48 마지막으로 완성된 프레임 seq (0 이면 없음)
+    uint32_t reserved0;                 // 56
+    uint32_t writerPid;                 // 60
+    uint64_t generation;                // 64 같은 이름으로 다시 만들 때마다 증가
+    uint8_t reserved[56];
+};
+static_assert(sizeof(ShmRingHeader) == 128, "ShmRingHeader layout");
+
+struct ShmSlotHeader {
+    std::atomic<uint64_t> lock;  //  0 seqlock
+    uint64_t seq;                //  8
+    uint64_t captureNs;          // 16 steady clock (CLOCK_MONOTONIC) 기준
+    uint32_t width;              // 24
+    uint32_t height;             // 28
+    uint32_t format;             // 32 ShmFormat
+    uint32_t rowBytes;           // 36
+    uint64_t bytes;              // 40
+    uint8_t reserved[16];
+};
+static_assert(sizeof(ShmSlotHeader) == 64, "ShmSlotHeader layout");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shm atomics must be lock-free");
+
+// ---- 쓰는 쪽 (노드) ----
+// 객체는 첫 write 때 그 프레임 크기로 만든다. 한 스레드에서만 부른다.
+class ShmFrameWriter {
+public:
+    ShmFrameWriter() = default;
+    ~ShmFrameWriter() { close(); }
+    ShmFrameWriter(const ShmFrameWriter &) = delete;
+    ShmFrameWriter &operator=(const ShmFrameWriter &) = delete;
+
+    // name 은 "/infiray_thermal_temp" 처럼 '/' 로 시작
+    void configure(const std::string &name, uint32_t slotCount);
+    // 객체를 stale 로 표시하고 이름을 지운다
+    void close();
+
+    // 한 프레임 복사 (행 단위, srcStride 는 원본의 행 간격)
+    bool write(ShmFormat format, uint32_t width, uint32_t height, uint32_t rowBytes, const void *data,
+               size_t srcStride, uint64_t captureNs);
+
+    const std::string &name() const { return name_; }
+    uint64_t written() const { return seq_; }
+
+private:
+    bool create(uint64_t slotBytes);
+
+    std::string name_;
+    uint32_t slotCount_ = 4;
+    uint64_t generation_ = 0;
+    ShmRingHeader *header_ = nullptr;
+    size_t mapBytes_ = 0;
+    uint64_t seq_ = 0;
+};
+
+// ---- 읽는 쪽 (리더 라이브러리) ----
+struct ShmFrameView {
+    uint64_t seq = 0;
+    uint64_t captureNs = 0;
+    uint32_t width = 0, height = 0;
+    uint32_t format = kShmNone;
+    uint32_t rowBytes = 0;
+    const uint8_t *data = nullptr;  // 공유 메모리를 직접 가리킨다 (복사 없음)
+    size_t bytes = 0;
+
+    const ShmSlotHeader *slot = nullptr;
+    uint64_t lock = 0;
+};
+
+class ShmFrameReader {
+public:
+    ShmFrameReader() = default;
+    explicit ShmFrameReader(const std::string &name) : name_(name) {}
+    ~ShmFrameReader() { close(); }
+    ShmFrameReader(const ShmFrameReader &) = delete;
+    ShmFrameReader &operator=(const ShmFrameReader &) = delete;
+
+    // 아직 쓰는 쪽이 없으면 false (latest/waitNew 가 다시 시도한다)
+    bool open(const std::string &name);
+    void close();
+    bool isOpen() const { return header_ != nullptr; }
+
+    // 아직 보지 않은 최신 프레임을 복사 없이 가리킨다. 새 프레임이 없으면 false.
+    // view.data 를 다 쓴 뒤 valid(view) 로 그 사이 덮어쓰이지 않았는지 확인한다.
+    bool latest(ShmFrameView &view);
+    bool valid(const ShmFrameView &view) const;
+
+    // 최신 프레임을 out 으로 복사 (덮어쓰이면 다시 시도). 새 프레임이 없으면 false.
+    bool copyLatest(std::vector<uint8_t> &out, ShmFrameView &meta);
+
+    // 새 프레임이 올 때까지 기다린다 (Linux 는 futex, 그 외는 짧은 폴링). 시간 초과면 false.
+    bool waitNew(std::chrono::milliseconds timeout);
+
+    // 쓰는 쪽이 먼저 덮어써서 놓친 횟수 (latest/copyLatest)
+    uint64_t torn() const { return torn_; }
+
+private:
+    bool ensureOpen();
+    const ShmSlotHeader *slotAt(uint64_t seq) const;
+
+    std::string name_;
+    ShmRingHeader *header_ = nullptr;
+    size_t mapBytes_ = 0;
+    uint64_t lastSeq_ = 0;
+    uint64_t torn_ = 0;
+};
+
+}  // namespace infiray
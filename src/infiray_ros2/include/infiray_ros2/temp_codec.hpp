@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace infiray {
+
+// ---- B타입(DeviceType 1) 온도 버퍼 변환 ----
+// SDK 버퍼(길이 2N)는 앞 N 바이트에 상위 바이트, 뒤 N 바이트에 하위 바이트가
+// 픽셀 쌍 단위로 뒤바뀐 채 들어 있다.
+//   out[2i]   = (buf[2i]   << 8) + buf[N + 2i + 1]
+//   out[2i+1] = (buf[2i+1] << 8) + buf[N + 2i]
+
+// 기준 구현 (기존 tempCallBack 루프 그대로). SIMD 결과 검증에 사용한다.
+inline void decodeTempBScalar(const uint8_t *buf, size_t numPixels, uint16_t *out) {
+    for (size_t ii = 0; ii < numPixels / 2; ii++) {
+        out[ii * 2]     = (uint16_t)((buf[ii * 2] << 8)     + buf[ii * 2 + 1 + numPixels]);
+        out[ii * 2 + 1] = (uint16_t)((buf[ii * 2 + 1] << 8) + buf[ii * 2 + numPixels]);
+    }
+}
+
+// 빌드 타깃에 맞는 SIMD 경로 (AVX2 / SSE2 / NEON, 없으면 스칼라)
+void decodeTempB(const uint8_t *buf, size_t numPixels, uint16_t *out);
+
+// 컴파일된 경로 이름 ("avx2", "sse2", "neon", "scalar")
+const char *decodeTempBPath();
+
+// 디코딩된 온도(raw) 배열을 SDK 원본 배열로 되돌린다 (합성/재생 소스용)
+inline void encodeTempB(const uint16_t *src, size_t numPixels, uint8_t *dst) {
+    uint8_t *hi = dst;
+    uint8_t *lo = dst + numPixels;
+    for (size_t i = 0; i + 1 < numPixels; i += 2) {
+        hi[i]     = (uint8_t)(src[i] >> 8);
+        hi[i + 1] = (uint8_t)(src[i + 1] >> 8);
+        lo[i + 1] = (uint8_t)(src[i] & 0xFF);
+        lo[i]     = (uint8_t)(src[i + 1] & 0xFF);
+    }
+}
+
+// ---- raw -> 섭씨 변환 (B타입 구간별 공식) ----
+// raw > split : (raw + highOffset) / highDivisor - kelvin
+// 그 외       : (raw + lowOffset)  / lowDivisor  - kelvin
+struct RawConversionB {
+    static constexpr double split = 7300.0;
+    static constexpr double lowOffset = 7000.0;
+    static constexpr double lowDivisor = 30.0;
+    static constexpr double highOffset = -3300.0;
+    static constexpr double highDivisor = 15.0;
+    static constexpr double kelvin = 273.15;
+};
+
+inline double rawToCelsius(double raw) {
+    using C = RawConversionB;
+    if (raw > C::split) return (raw + C::highOffset) / C::highDivisor - C::kelvin;
+    return (raw + C::lowOffset) / C::lowDivisor - C::kelvin;
+}
+
+// 같은 공식을 1/30 K 단위 정수로 쓴 형태 (분기 없이 SIMD 로 합산 가능, 7000 ~ 26166)
+//   raw > split : 2*raw - 6600,  그 외 : raw + 7000
+inline int32_t rawToKelvin30(uint16_t raw) {
+    const int32_t r = raw;
+    return r > (int32_t)RawConversionB::split ? 2 * r - 6600 : r + 7000;
+}
+
+inline double kelvin30ToCelsius(double k30) { return k30 / 30.0 - RawConversionB::kelvin; }
+
+// ---- raw -> 섭씨 LUT (14비트 전 구간, 최초 호출 시 한 번 생성) ----
+constexpr int kRawLevels = 16384;
+
+struct CelsiusLut {
+    float celsius[kRawLevels];
+};
+
+const CelsiusLut &celsiusLut();
+
+// 14비트를 넘는 값은 최댓값으로 본다
+inline uint16_t clampRaw(uint16_t raw) { return raw < kRawLevels ? raw : (uint16_t)(kRawLevels - 1); }
+
+// 구간별 변환 공식의 역함수. 203.5 C 이하는 하위 구간, 그 위는 상위 구간을 쓴다.
+inline uint16_t celsiusToRaw(double celsius) {
+    double k = celsius + 273.15;
+    double raw = (celsius <= 203.5) ? k * 30.0 - 7000.0 : k * 15.0 + 3300.0;
+    if (raw < 0.0) raw = 0.0;
+    if (raw > 16383.0) raw = 16383.0;
+    return (uint16_t)(raw + 0.5);
+}
+
+}  // namespace infiray
@@ -0,0 +1,197 @@
+#include "infiray_ros2/blob_tracker.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "infiray_ros2/temp_codec.hpp"
+
+namespace infiray {
+
+BlobTracker::BlobTracker(const BlobTrackerConfig &cfg) : cfg_(cfg) {
+    thresholdK30_ = (int32_t)std::lround((cfg_.thresholdC + RawConversionB::kelvin) * 30.0);
+}
+
+int BlobTracker::findRoot(int i) {
+    while (runs_[i].parent != i) {
+        runs_[i].parent = runs_[runs_[i].parent].parent;  // 경로 절반 압축
+        i = runs_[i].parent;
+    }
+    return i;
+}
+
+void BlobTracker::segment(const uint16_t *temp, int width, int height) {
+    runs_.clear();
+    rowMask_.resize(width);
+    uint8_t *rowMask = rowMask_.data();
+    size_t prevBegin = 0, prevEnd = 0;
+
+    for (int y = 0; y < height; y++) {
+        const uint16_t *row = temp + (size_t)y * width;
+        const size_t curBegin = runs_.size();
+        size_t j = prevBegin;  // 윗행 run 탐색 위치 (x 순이라 되돌아가지 않는다)
+
+        // 임계값 비교는 분기 없이 한 번에 (벡터화), run 탐색은 바이트 마스크로
+        for (int x = 0; x < width; x++) rowMask[x] = rawToKelvin30(row[x]) >= thresholdK30_;
+
+        int x = 0;
+        while (x < width) {
+            while (x < width && !rowMask[x]) x++;
+            if (x >= width) break;
+            const int x0 = x;
+            while (x < width && rowMask[x]) x++;
+            const int x1 = x - 1;
+
+            const int idx = (int)runs_.size();
+            runs_.push_back({y, x0, x1, idx});
+
+            // 8-연결: 윗행 run 이 [x0-1, x1+1] 과 겹치면 같은 덩어리
+            while (j < prevEnd && runs_[j].x1 + 1 < x0) j++;
+            for (size_t k = j; k < prevEnd && runs_[k].x0 <= x1 + 1; k++) {
+                const int a = findRoot(idx);
+                const int b = findRoot((int)k);
+                if (a != b) runs_[std::max(a, b)].parent = std::min(a, b);
+            }
+        }
+        prevBegin = curBegin;
+        prevEnd = runs_.size();
+    }
+
+    // run 을 루트별로 모아 면적/중심/온도 통계를 낸다
+    comps_.clear();
+    rootToComp_.assign(runs_.size(), -1);
+    for (size_t i = 0; i < runs_.size(); i++) {
+        const int root = findRoot((int)i);
+        if (rootToComp_[root] < 0) {
+            rootToComp_[root] = (int)comps_.size();
+            Component c;
+            c.x0 = runs_[i].x0;
+            c.x1 = runs_[i].x1;
+            c.y0 = c.y1 = runs_[i].y;
+            comps_.push_back(c);
+        }
+        Component &c = comps_[rootToComp_[root]];
+        const Run &r = runs_[i];
+        const int len = r.x1 - r.x0 + 1;
+        c.area += len;
+        c.sumX += (int64_t)(r.x0 + r.x1) * len / 2;
+        c.sumY += (int64_t)r.y * len;
+        c.x0 = std::min(c.x0, r.x0);
+        c.x1 = std::max(c.x1, r.x1);
+        c.y0 = std::min(c.y0, r.y);
+        c.y1 = std::max(c.y1, r.y);
+        const uint16_t *row = temp + (size_t)r.y * width;
+        for (int x = r.x0; x <= r.x1; x++) {
+            const int32_t k = rawToKelvin30(row[x]);
+            c.sumK30 += k;
+            c.maxK30 = std::max(c.maxK30, k);
+        }
+    }
+
+    detections_.clear();
+    for (const auto &c : comps_) {
+        if (c.area < cfg_.minArea) continue;
+        TrackedBlob b;
+        b.cx = (float)((double)c.sumX / c.area);
+        b.cy = (float)((double)c.sumY / c.area);
+        b.area = c.area;
+        b.x = c.x0;
+        b.y = c.y0;
+        b.w = c.x1 - c.x0 + 1;
+        b.h = c.y1 - c.y0 + 1;
+        b.maxCelsius = (float)kelvin30ToCelsius(c.maxK30);
+        b.meanCelsius = (float)kelvin30ToCelsius((double)c.sumK30 / c.area);
+        detections_.push_back(b);
+    }
+    if ((int)detections_.size() > cfg_.maxBlobs) {
+        std::partial_sort(detections_.begin(), detections_.begin() + cfg_.maxBlobs, detections_.end(),
+                          [](const TrackedBlob &a, const TrackedBlob &b) { return a.area > b.area; });
+        detections_.resize(cfg_.maxBlobs);
+    }
+}
+
+void BlobTracker::associate(double dt) {
+    const float fdt = (float)dt;
+    const float gate2 = (float)(cfg_.maxMatchDistPx * cfg_.maxMatchDistPx);
+
+    // 예측 위치와 가까운 쌍부터 짝짓는다
+    pairs_.clear();
+    for (int t = 0; t < (int)tracks_.size(); t++) {
+        const float px = tracks_[t].cx + tracks_[t].vx * fdt;
+        const float py = tracks_[t].cy + tracks_[t].vy * fdt;
+        for (int d = 0; d < (int)detections_.size(); d++) {
+            const float dx = detections_[d].cx - px;
+            const float dy = detections_[d].cy - py;
+            const float d2 = dx * dx + dy * dy;
+            if (d2 <= gate2) pairs_.push_back({d2, t, d});
+        }
+    }
+    std::sort(pairs_.begin(), pairs_.end(), [](const Pair &a, const Pair &b) { return a.d2 < b.d2; });
+
+    trackUsed_.assign(tracks_.size(), 0);
+    detUsed_.assign(detections_.size(), 0);
+    const float alpha = (float)std::clamp(cfg_.velocitySmoothing, 0.0, 1.0);
+    for (const Pair &p : pairs_) {
+        if (trackUsed_[p.track] || detUsed_[p.det]) continue;
+        trackUsed_[p.track] = detUsed_[p.det] = 1;
+
+        TrackedBlob &t = tracks_[p.track];
+        const TrackedBlob &d = detections_[p.det];
+        // 놓쳤던 프레임 동안은 예측으로 위치를 옮겨 두었으므로 이번 간격만으로 속도를 낸다
+        const float vx = (d.cx - t.cx) / fdt;
+        const float vy = (d.cy - t.cy) / fdt;
+        const float a = t.age > 1 ? alpha : 1.0f;
+        const uint32_t id = t.id;
+        const uint32_t age = t.age;
+        const float oldVx = t.vx, oldVy = t.vy;
+        t = d;
+        t.id = id;
+        t.age = age + 1;
+        t.missed = 0;
+        t.vx = a * vx + (1.0f - a) * oldVx;
+        t.vy = a * vy + (1.0f - a) * oldVy;
+    }
+
+    // 안 보인 추적은 예측 위치로 옮겨 두고, 오래되면 지운다
+    size_t keep = 0;
+    for (size_t t = 0; t < tracks_.size(); t++) {
+        TrackedBlob &tr = tracks_[t];
+        if (!trackUsed_[t]) {
+            tr.missed++;
+            tr.cx += tr.vx * fdt;
+            tr.cy += tr.vy * fdt;
+            if (tr.missed > cfg_.maxMissedFrames) continue;
+        }
+        if (keep != t) tracks_[keep] = tr;
+        keep++;
+    }
+    tracks_.resize(keep);
+
+    // 짝이 없는 검출은 새 ID (ID 는 늘기만 하므로 tracks_ 는 ID 순을 유지한다)
+    for (size_t d = 0; d < detections_.size(); d++) {
+        if (detUsed_[d]) continue;
+        TrackedBlob t = detections_[d];
+        t.id = nextId_++;
+        t.age = 1;
+        tracks_.push_back(t);
+    }
+}
+
+const std::vector<TrackedBlob> &BlobTracker::update(const uint16_t *temp, int width, int height,
+                                                    uint64_t captureNs) {
+    visible_.clear();
+    if (temp == nullptr || width <= 0 || height <= 0) return visible_;
+
+    double dt = (lastNs_ > 0 && captureNs > lastNs_) ? (captureNs - lastNs_) * 1e-9 : 1.0 / 30.0;
+    lastNs_ = captureNs;
+    dt = std::clamp(dt, 1e-3, 1.0);
+
+    segment(temp, width, height);
+    associate(dt);
+
+    for (const auto &t : tracks_) {
+        if (t.missed == 0) visible_.push_back(t);
+    }
+    return visible_;
+}
+
+}  // namespace infiray
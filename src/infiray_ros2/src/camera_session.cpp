@@ -0,0 +1,1033 @@
+#include "infiray_ros2/camera_session.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+#include <opencv2/opencv.hpp>
+
+#include "infiray_ros2/temp_codec.hpp"
+
+namespace infiray_ros2 {
+
+using infiray::Stage;
+using infiray::steadyNowNs;
+
+// 발행한 이미지는 구독자가 놓을 때까지 참조되므로, 참조가 풀에만 남은 버퍼를 재사용한다.
+// 다른 스레드의 구독자가 refcount 를 줄이므로 OpenCV 와 같은 원자 연산(더하기 0)으로 읽는다.
+static cv::Mat acquirePooled(cv::Mat (&pool)[4], int w, int h, int type) {
+    for (auto &m : pool) {
+        if (m.empty() || (m.u != nullptr && CV_XADD(&m.u->refcount, 0) == 1)) {
+            m.create(h, w, type);
+            return m;
+        }
+    }
+    return cv::Mat(h, w, type);  // 전부 사용 중이면 새로 할당
+}
+
+// ---- 오버레이 팔레트 (render.palette, 화면 창의 숫자 키 1.. 순서) ----
+struct PaletteName {
+    const char *name;
+    int colormap;  // cv::COLORMAP_*, 회색은 -1
+};
+static const PaletteName kPaletteNames[] = {
+    {"gray", -1},
+    {"inferno", cv::COLORMAP_INFERNO},
+    {"jet", cv::COLORMAP_JET},
+    {"hot", cv::COLORMAP_HOT},
+    {"magma", cv::COLORMAP_MAGMA},
+    {"plasma", cv::COLORMAP_PLASMA},
+    {"bone", cv::COLORMAP_BONE},
+    {"rainbow", cv::COLORMAP_RAINBOW},
+};
+
+// OpenCV 컬러맵을 0..255 램프에 한 번 적용해 256 항목 LUT 로 만든다 (렌더 때는 OpenCV 를 거치지 않는다)
+static infiray::Palette8 makePalette(int colormap) {
+    if (colormap < 0) return infiray::grayPalette();
+    cv::Mat ramp(1, 256, CV_8UC1), bgr;
+    for (int i = 0; i < 256; i++) ramp.at<uint8_t>(0, i) = (uint8_t)i;
+    cv::applyColorMap(ramp, bgr, colormap);
+    return infiray::paletteFromBgr(bgr.ptr<uint8_t>(0));
+}
+
+// 고정 크기 메시지는 RMW 가 지원하면 loaned message 로 보낸다
+template <typename MsgT>
+static void publishScalar(const typename rclcpp::Publisher<MsgT>::SharedPtr &pub,
+                          decltype(MsgT::data) value) {
+    if (pub->can_loan_messages()) {
+        auto loaned = pub->borrow_loaned_message();
+        loaned.get().data = value;
+        pub->publish(std::move(loaned));
+    } else {
+        auto msg = std::make_unique<MsgT>();
+        msg->data = value;
+        pub->publish(std::move(msg));
+    }
+}
+
+CameraSession::CameraSession(rclcpp::Node &node, const std::string &name, const SessionOptions &opts)
+    : node_(node), name_(name), opts_(opts), fireDetector_(opts.fire), blobTracker_(opts.blobs) {
+    paramPrefix_ = name_.empty() ? "" : name_ + ".";
+    const std::string topicPrefix = name_.empty() ? "/thermal/" : "/thermal/" + name_ + "/";
+    frameId_ = node_.declare_parameter(paramPrefix_ + "frame_id",
+                                       name_.empty() ? std::string("thermal_camera_frame")
+                                                     : name_ + "_thermal_camera_frame");
+    windowName_ = name_.empty() ? "Thermal" : "Thermal " + name_;
+    outputQueue_.setCapacity((size_t)std::max(1, opts_.queueDepth));
+    // 스트림 시작 전에 링 용량을 잡아 둔다 (콜백 경로에서는 할당하지 않는다)
+    yuvRing_.reserve(opts_.captureYOnly ? kMaxPixels : kMaxPixels * 3 / 2);
+    tempRing_.reserve(kMaxPixels);
+    if (opts_.prefaultBuffers) {
+        yuvRing_.prefault();
+        tempRing_.prefault();
+    }
+    for (const auto &p : kPaletteNames) {
+        palettes_.push_back(makePalette(p.colormap));
+        if (opts_.palette == p.name) paletteIndex_.store((int)palettes_.size() - 1);
+    }
+    if (opts_.palette != kPaletteNames[paletteIndex_.load()].name) {
+        std::cerr << "Unknown render.palette: " << opts_.palette
+                  << " (gray/inferno/jet/hot/magma/plasma/bone/rainbow)\n";
+    }
+    auto periodNs = [](double hz) { return hz > 0.0 ? (uint64_t)(1e9 / hz) : 0; };
+    imageGate_.periodNs = periodNs(opts_.imageHz);
+    compressedGate_.periodNs = periodNs(opts_.compressedHz);
+    rawGate_.periodNs = periodNs(opts_.rawHz);
+    displayQueue_.setCapacity((size_t)std::max(1, opts_.queueDepth));
+    encodeQueue_.setCapacity((size_t)std::max(1, opts_.queueDepth));
+
+    // [수정점 1] QoS 프로필을 SensorData (Best Effort)로 변경하여 네트워크 지연 방지
+    auto qos = rclcpp::SensorDataQoS();
+    image_pub_ = node_.create_publisher<ImageContainer>(topicPrefix + "image", qos);
+    // image_transport 의 compressed 토픽 이름/형식을 따르므로 rqt_image_view 등에서 바로 보인다
+    if (opts_.compressedFormat == "jpeg") {
+        encodeExt_ = ".jpg";
+        encodeParams_ = {cv::IMWRITE_JPEG_QUALITY, std::clamp(opts_.jpegQuality, 1, 100)};
+        compressedMsg_.format = "bgr8; jpeg compressed bgr8";
+    } else if (opts_.compressedFormat == "png") {
+        encodeExt_ = ".png";
+        encodeParams_ = {cv::IMWRITE_PNG_COMPRESSION, std::clamp(opts_.pngLevel, 0, 9)};
+        compressedMsg_.format = "bgr8; png compressed bgr8";
+    } else if (opts_.compressedFormat != "none") {
+        std::cerr << "Unknown compressed.format: " << opts_.compressedFormat << " (jpeg/png/none)\n";
+    }
+    if (!encodeExt_.empty()) {
+        compressed_pub_ = node_.create_publisher<sensor_msgs::msg::CompressedImage>(
+            topicPrefix + "image/compressed", qos);
+    }
+    temp_pub_ = node_.create_publisher<std_msgs::msg::Float32>(topicPrefix + "max_temp", qos);
+    fire_pub_ = node_.create_publisher<std_msgs::msg::Bool>(topicPrefix + "fire_detected", qos);
+    fire_conf_pub_ = node_.create_publisher<std_msgs::msg::Float32>(topicPrefix + "fire_confidence", qos);
+    if (opts_.publishFireMask) {
+        fire_mask_pub_ = node_.create_publisher<ImageContainer>(topicPrefix + "fire_mask", qos);
+    }
+    raw_pub_ = node_.create_publisher<ImageContainer>(topicPrefix + "raw", qos);
+    hotspots_pub_ = node_.create_publisher<infiray_ros2::msg::HotspotArray>(topicPrefix + "hotspots", qos);
+    if (opts_.blobsEnabled) {
+        blobs_pub_ = node_.create_publisher<infiray_ros2::msg::ThermalBlobArray>(topicPrefix + "blobs", qos);
+    }
+    info_pub_ = node_.create_publisher<sensor_msgs::msg::CameraInfo>(topicPrefix + "camera_info", qos);
+
+    // ---- 온도 통계: 프레임 전체 + 카메라별 다각형 ROI ----
+    //   stats.roi_names:=[battery,charger] stats.roi.battery:=[x0,y0,x1,y1,x2,y2,...] (픽셀 좌표)
+    if (opts_.statsEnabled) {
+        std::vector<infiray::StatsRoi> rois;
+        const auto roiNames = node_.declare_parameter(paramPrefix_ + "stats.roi_names", std::vector<std::string>{});
+        for (const auto &roiName : roiNames) {
+            infiray::StatsRoi roi;
+            roi.name = roiName;
+            for (double v : node_.declare_parameter(paramPrefix_ + "stats.roi." + roiName, std::vector<double>{})) {
+                roi.xy.push_back((float)v);
+            }
+            rois.push_back(std::move(roi));
+        }
+        statsEngine_.configure(rois, opts_.statsPercentiles);
+        stats_pub_ = node_.create_publisher<infiray_ros2::msg::ThermalStatsArray>(topicPrefix + "stats", qos);
+        if (!statsEngine_.roiDefs().empty()) {
+            std::cout << "[" << windowName_ << "] Stats ROIs: " << statsEngine_.roiDefs().size() << "\n";
+        }
+    }
+
+    if (opts_.shmEnabled) {
+        const std::string base = name_.empty() ? "/infiray_thermal" : "/infiray_" + name_;
+        shmTemp_.configure(base + "_temp", (uint32_t)opts_.shmSlots);
+        shmImage_.configure(base + "_image", (uint32_t)opts_.shmSlots);
+        std::cout << "[" << windowName_ << "] Shared memory: " << shmTemp_.name() << ", " << shmImage_.name() << "\n";
+    }
+
+    source_ = makeFrameSource();
+    if (!source_) throw std::runtime_error("Frame source init failed: " + (name_.empty() ? "camera" : name_));
+    std::cout << "[" << windowName_ << "] Frame Source: " << source_->name() << "\n";
+    // Ctrl+C 등으로 context 가 내려가면 대기 중인 분석 스레드를 바로 깨운다
+    shutdownHandle_ =
+        node_.get_node_base_interface()->get_context()->add_on_shutdown_callback([this] { wakeWorker(); });
+
+    // ---- 녹화: 미리 잡은 세그먼트 파일에 mmap 으로 기록, segment_mb 마다 다음 파일 ----
+    infiray::MmapRecorderConfig rec;
+    rec.path = node_.declare_parameter(paramPrefix_ + "record_path", std::string(""));
+    const int64_t segmentMb = node_.declare_parameter(paramPrefix_ + "record.segment_mb", (int64_t)1024);
+    rec.maxSegments = (int)node_.declare_parameter(paramPrefix_ + "record.max_segments", (int64_t)0);
+    const int64_t queueMb = node_.declare_parameter(paramPrefix_ + "record.queue_mb", (int64_t)64);
+    const int64_t writebackMb = node_.declare_parameter(paramPrefix_ + "record.writeback_mb", (int64_t)16);
+    const std::string recordVideo = node_.declare_parameter(paramPrefix_ + "record.video", std::string("y"));
+    rec.segmentBytes = (uint64_t)std::max<int64_t>(16, segmentMb) << 20;
+    rec.queueBytes = (size_t)std::max<int64_t>(4, queueMb) << 20;
+    // 가장 큰 레코드는 kMaxPixels 의 온도 raw (yuv420 영상 1.5 바이트/픽셀보다 크다)
+    rec.recordBytes = sizeof(infiray::RecordHeader) + kMaxPixels * sizeof(uint16_t);
+    rec.writebackBytes = (size_t)std::max<int64_t>(1, writebackMb) << 20;
+    if (recordVideo == "yuv420") {
+        recordVideo_ = infiray::kVideoYuv420;
+    } else if (recordVideo == "none") {
+        recordVideo_ = infiray::kVideoNone;
+    } else if (recordVideo != "y") {
+        std::cerr << "Unknown record.video: " << recordVideo << " (y/yuv420/none)\n";
+    }
+    if (!rec.path.empty()) {
+        if (recorder_.open(rec)) {
+            recording_.store(true);
+            std::cout << "[" << windowName_ << "] Recording to " << infiray::MmapRecorder::segmentPath(rec.path, 0)
+                      << " (" << (rec.segmentBytes >> 20) << " MB segments)\n";
+        } else {
+            std::cerr << "Cannot open record file: " << rec.path << "\n";
+        }
+    }
+}
+
+CameraSession::~CameraSession() {
+    stop();
+    node_.get_node_base_interface()->get_context()->remove_on_shutdown_callback(shutdownHandle_);
+    std::cout << "[" << windowName_ << "] Video frames: " << yuvRing_.published()
+              << " (overwritten " << yuvRing_.overwritten() << ")\n";
+    std::cout << "[" << windowName_ << "] Temp frames: " << tempRing_.published()
+              << " (overwritten " << tempRing_.overwritten() << ")\n";
+    std::cout << "[" << windowName_ << "] Callback copy: " << (videoCopyBytes_.load() >> 20) << " MB video"
+              << (opts_.captureYOnly ? " (Y only)" : "") << ", reallocations " << yuvRing_.grown() + tempRing_.grown()
+              << "\n";
+    std::cout << "[" << windowName_ << "] Output queue: " << outputQueue_.pushed()
+              << " (dropped " << outputQueue_.dropped() << ")\n";
+    if (opts_.showDisplay) {
+        std::cout << "[" << windowName_ << "] Display queue: " << displayQueue_.pushed()
+                  << " (dropped " << displayQueue_.dropped() << ")\n";
+    }
+    if (!encodeExt_.empty()) {
+        std::cout << "[" << windowName_ << "] Encode queue: " << encodeQueue_.pushed()
+                  << " (dropped " << encodeQueue_.dropped() << ")\n";
+    }
+    recording_.store(false);
+    if (recorder_.isOpen()) {
+        recorder_.close();
+        std::cout << "[" << windowName_ << "] Recorded: " << recorder_.recorded() << " frames, "
+                  << (recorder_.bytesWritten() >> 20) << " MB in " << recorder_.segments()
+                  << " segment(s) (dropped " << recorder_.dropped() << ")\n";
+    }
+}
+
+// ---- 프레임 소스 선택 (sdk / synthetic / replay) ----
+std::unique_ptr<infiray::FrameSource> CameraSession::makeFrameSource() {
+    const std::string &p = paramPrefix_;
+    const std::string kind = node_.declare_parameter(p + "source", std::string("sdk"));
+
+    if (kind == "synthetic") {
+        infiray::SyntheticSourceConfig cfg;
+        cfg.width = node_.declare_parameter(p + "synthetic.width", cfg.width);
+        cfg.height = node_.declare_parameter(p + "synthetic.height", cfg.height);
+        cfg.fps = node_.declare_parameter(p + "synthetic.fps", cfg.fps);
+        cfg.numBlobs = node_.declare_parameter(p + "synthetic.blobs", cfg.numBlobs);
+        cfg.blobPeakC = node_.declare_parameter(p + "synthetic.blob_peak_c", cfg.blobPeakC);
+        cfg.maxFrames = node_.declare_parameter(p + "synthetic.max_frames", (int64_t)cfg.maxFrames);
+        return std::make_unique<infiray::SyntheticFrameSource>(cfg);
+    }
+
+    if (kind == "replay") {
+        infiray::ReplaySourceConfig cfg;
+        cfg.path = node_.declare_parameter(p + "replay.path", std::string(""));
+        cfg.realtime = node_.declare_parameter(p + "replay.realtime", cfg.realtime);
+        cfg.loop = node_.declare_parameter(p + "replay.loop", cfg.loop);
+        return std::make_unique<infiray::ReplayFrameSource>(cfg);
+    }
+
+    infiray::SdkSourceConfig cfg;
+    cfg.ip = node_.declare_parameter(p + "camera_ip", cfg.ip);
+    cfg.port = node_.declare_parameter(p + "camera_port", cfg.port);
+    return infiray::makeSdkFrameSource(cfg);
+}
+
+bool CameraSession::start() {
+    running_.store(true);
+    source_->setCallbacks(&CameraSession::videoCallBack, &CameraSession::tempCallBack, this,
+                          &CameraSession::endCallBack);
+    if (!source_->start()) {
+        running_.store(false);
+        return false;
+    }
+    // ROS 콜백은 외부 executor 가 처리하고, 프레임 처리는 카메라별 단계 스레드에서 돈다
+    if (opts_.showDisplay) display_ = std::thread(&CameraSession::displayLoop, this);
+    if (!encodeExt_.empty()) encoder_ = std::thread(&CameraSession::encoderLoop, this);
+    output_ = std::thread(&CameraSession::outputLoop, this);
+    analytics_ = std::thread(&CameraSession::analyticsLoop, this);
+    tuneThread(analytics_.native_handle(), opts_.analyticsTuning, "analytics");
+    tuneThread(output_.native_handle(), opts_.outputTuning, "output");
+    if (encoder_.joinable()) tuneThread(encoder_.native_handle(), opts_.outputTuning, "encoder");
+    return true;
+}
+
+// 설정이 있을 때만 적용하고, 적용 여부를 시작 로그로 남긴다
+void CameraSession::tuneThread(pthread_t thread, const infiray::ThreadTuning &tuning, const char *label) {
+    if (tuning.empty()) return;
+    std::string report;
+    const bool ok = infiray::applyThreadTuning(thread, tuning, report);
+    (ok ? std::cout : std::cerr) << "[" << windowName_ << "] " << label << " thread: " << report << "\n";
+}
+
+void CameraSession::stop() {
+    running_.store(false);
+    wakeWorker();
+    // 분석 -> 출력 -> 화면 순으로 끝낸다 (각 단계가 끝나면서 다음 큐를 닫는다)
+    if (analytics_.joinable()) analytics_.join();
+    outputQueue_.close();
+    if (output_.joinable()) output_.join();
+    displayQueue_.close();
+    encodeQueue_.close();
+    if (display_.joinable()) display_.join();
+    if (encoder_.joinable()) encoder_.join();
+    if (source_) source_->stop();
+}
+
+// ---- SDK 콜백: pContext 로 세션을 찾는다 ----
+void CameraSession::videoCallBack(char *pBuffer, long BufferLen, int width, int height, void *pContext) {
+    if (pContext == nullptr) return;
+    static_cast<CameraSession *>(pContext)->onVideo(pBuffer, BufferLen, width, height);
+}
+
+void CameraSession::tempCallBack(char *pBuffer, long BufferLen, void *pContext) {
+    if (pContext == nullptr) return;
+    static_cast<CameraSession *>(pContext)->onTemp(pBuffer, BufferLen);
+}
+
+void CameraSession::endCallBack(void *pContext) {
+    if (pContext == nullptr) return;
+    static_cast<CameraSession *>(pContext)->wakeWorker();
+}
+
+void CameraSession::wakeWorker() {
+    { std::lock_guard<std::mutex> lk(wakeMtx_); }
+    wakeCv_.notify_one();
+}
+
+void CameraSession::recordFrame(uint16_t videoFmt, uint16_t tempFmt, int width, int height, uint64_t captureNs,
+                                const void *video, size_t videoLen, const void *temp, size_t tempLen) {
+    infiray::RecordHeader rh{};
+    rh.videoFormat = videoFmt;
+    rh.tempFormat = tempFmt;
+    rh.captureNs = captureNs;
+    rh.width = (uint32_t)width;
+    rh.height = (uint32_t)height;
+    rh.videoBytes = (uint32_t)videoLen;
+    rh.tempBytes = (uint32_t)tempLen;
+    recorder_.append(rh, video, temp);  // 큐가 차면 버리고 센다 (콜백은 기다리지 않음)
+}
+
+// ---- 영상 콜백 ----
+void CameraSession::onVideo(char *pBuffer, long BufferLen, int width, int height) {
+    const long expected = (long)(width * height * 3 / 2);
+    if (BufferLen != expected || pBuffer == nullptr) return;
+
+    if (!videoThreadTuned_) {
+        videoThreadTuned_ = true;
+        tuneThread(pthread_self(), opts_.callbackTuning, "video callback");
+    }
+    width_.store(width, std::memory_order_relaxed);
+    height_.store(height, std::memory_order_relaxed);
+
+    // I420 의 앞 width*height 바이트가 Y 평면이다. 하류는 Y 만 쓰므로 기본은 U/V 를 복사하지 않는다.
+    const size_t copyBytes = opts_.captureYOnly ? (size_t)width * height : (size_t)BufferLen;
+    const uint64_t t0 = steadyNowNs();
+    auto &slot = yuvRing_.writeSlot(copyBytes);
+    slot.captureNs = t0;
+    slot.width = width;
+    slot.height = height;
+    std::memcpy(slot.data.data(), pBuffer, copyBytes);
+    yuvRing_.publish();
+    videoCopyBytes_.fetch_add(copyBytes, std::memory_order_relaxed);
+    stats_.record(Stage::kCallbackCopy, steadyNowNs() - t0);
+
+    if (recording_.load(std::memory_order_relaxed) && recordVideo_ != infiray::kVideoNone) {
+        // Y 평면만이면 I420 앞부분 (U/V 는 재생 시 128 로 채운다)
+        const size_t bytes = recordVideo_ == infiray::kVideoYOnly ? (size_t)width * height : (size_t)BufferLen;
+        recordFrame(recordVideo_, infiray::kTempNone, width, height, t0, pBuffer, bytes, nullptr, 0);
+    }
+
+    wakeWorker();
+}
+
+// ---- 온도 데이터 콜백 ----
+void CameraSession::onTemp(char *pBuffer, long BufferLen) {
+    if (pBuffer == nullptr || BufferLen <= 0) return;
+    if (!tempThreadTuned_) {
+        tempThreadTuned_ = true;
+        tuneThread(pthread_self(), opts_.callbackTuning, "temp callback");
+    }
+
+    const int numPixels = (int)TempDevice::pixelCount((size_t)BufferLen);
+
+    const uint64_t t0 = steadyNowNs();
+    auto &slot = tempRing_.writeSlot((size_t)numPixels);
+    slot.captureNs = t0;
+    slot.width = width_.load(std::memory_order_relaxed);
+    slot.height = height_.load(std::memory_order_relaxed);
+
+    // 장치 정책의 디코딩 (B타입은 SIMD 비트 교차 디코딩, 기준 구현은 decodeTempBScalar)
+    TempDevice::decode((const uint8_t *)pBuffer, numPixels, slot.data.data());
+    stats_.record(Stage::kDecode, steadyNowNs() - t0);
+    if (recording_.load(std::memory_order_relaxed) && slot.width * slot.height == numPixels) {
+        // 디코딩한 row-major raw 를 기록 (온도 콜백에는 해상도가 없어 마지막 영상 해상도를 쓴다)
+        recordFrame(infiray::kVideoNone, infiray::kTempDecodedU16, slot.width, slot.height, t0, nullptr, 0,
+                    slot.data.data(), (size_t)numPixels * 2);
+    }
+    tempRing_.publish();
+    wakeWorker();  // 분석 스레드가 짝짓기 이력에 넣는다
+}
+
+void CameraSession::publishHotspots(const std_msgs::msg::Header &header) {
+    const uint64_t t0 = steadyNowNs();
+    auto msg = std::make_unique<infiray_ros2::msg::HotspotArray>();
+    msg->header = header;
+    msg->hotspots.reserve(hotspots_.size());
+    for (const auto &h : hotspots_) {
+        infiray_ros2::msg::Hotspot m;
+        m.x = (uint16_t)h.x;
+        m.y = (uint16_t)h.y;
+        m.width = (uint16_t)h.w;
+        m.height = (uint16_t)h.h;
+        m.mean_celsius = (float)h.celsius;
+        msg->hotspots.push_back(m);
+    }
+    const uint64_t t1 = steadyNowNs();
+    hotspots_pub_->publish(std::move(msg));
+    stats_.record(Stage::kSerialize, t1 - t0);
+    stats_.record(Stage::kPublish, steadyNowNs() - t1);
+}
+
+void CameraSession::publishBlobs(const std_msgs::msg::Header &header,
+                                 const std::vector<infiray::TrackedBlob> &blobs) {
+    const uint64_t t0 = steadyNowNs();
+    auto msg = std::make_unique<infiray_ros2::msg::ThermalBlobArray>();
+    msg->header = header;
+    msg->blobs.resize(blobs.size());
+    for (size_t i = 0; i < blobs.size(); i++) {
+        const auto &b = blobs[i];
+        auto &m = msg->blobs[i];
+        m.id = b.id;
+        m.centroid_x = b.cx;
+        m.centroid_y = b.cy;
+        m.area = (uint32_t)b.area;
+        m.x = (uint16_t)b.x;
+        m.y = (uint16_t)b.y;
+        m.width = (uint16_t)b.w;
+        m.height = (uint16_t)b.h;
+        m.max_celsius = b.maxCelsius;
+        m.mean_celsius = b.meanCelsius;
+        m.velocity_x = b.vx;
+        m.velocity_y = b.vy;
+        m.age = b.age;
+    }
+    const uint64_t t1 = steadyNowNs();
+    blobs_pub_->publish(std::move(msg));
+    stats_.record(Stage::kSerialize, t1 - t0);
+    stats_.record(Stage::kPublish, steadyNowNs() - t1);
+}
+
+void CameraSession::publishStats(const std_msgs::msg::Header &header) {
+    const uint64_t t0 = steadyNowNs();
+    auto msg = std::make_unique<infiray_ros2::msg::ThermalStatsArray>();
+    msg->header = header;
+    const auto &levels = statsEngine_.percentiles();
+    msg->percentiles.assign(levels.begin(), levels.end());
+    auto fill = [](infiray_ros2::msg::ThermalStats &m, const std::string &name, const infiray::RegionStats &s) {
+        m.name = name;
+        m.pixels = s.pixels;
+        m.min_celsius = s.minCelsius;
+        m.max_celsius = s.maxCelsius;
+        m.mean_celsius = s.meanCelsius;
+        m.percentile_celsius = s.percentileCelsius;
+    };
+    fill(msg->frame, "frame", statsEngine_.frame());
+    const auto &defs = statsEngine_.roiDefs();
+    msg->rois.resize(defs.size());
+    for (size_t i = 0; i < defs.size(); i++) fill(msg->rois[i], defs[i].name, statsEngine_.rois()[i]);
+    const uint64_t t1 = steadyNowNs();
+    stats_pub_->publish(std::move(msg));
+    stats_.record(Stage::kSerialize, t1 - t0);
+    stats_.record(Stage::kPublish, steadyNowNs() - t1);
+}
+
+// 분석 단계에서 풀 버퍼로 복사해 둔 온도 프레임을 mono16 으로 발행 (새 온도 프레임마다, rate.raw_hz 에 따라)
+void CameraSession::publishRaw(const std_msgs::msg::Header &header, const cv::Mat &raw) {
+    const uint64_t t0 = steadyNowNs();
+    auto image = std::make_unique<ImageContainer>(raw, header, false, "mono16");
+    // 보정값이 없으므로 K/P 는 0 (uncalibrated). 이미지와 같은 stamp/frame_id 로 짝을 맞춘다.
+    auto info = std::make_unique<sensor_msgs::msg::CameraInfo>();
+    info->header.stamp = header.stamp;
+    info->header.frame_id = frameId_;
+    info->width = (uint32_t)raw.cols;
+    info->height = (uint32_t)raw.rows;
+    const uint64_t t1 = steadyNowNs();
+
+    raw_pub_->publish(std::move(image));
+    info_pub_->publish(std::move(info));
+    stats_.record(Stage::kSerialize, t1 - t0);
+    stats_.record(Stage::kPublish, steadyNowNs() - t1);
+}
+
+void CameraSession::publishImage(const rclcpp::Publisher<ImageContainer>::SharedPtr &pub,
+                                 const std_msgs::msg::Header &header, const cv::Mat &mat, const char *encoding) {
+    const uint64_t t0 = steadyNowNs();
+    auto image = std::make_unique<ImageContainer>(mat, header, false, encoding);
+    const uint64_t t1 = steadyNowNs();
+    pub->publish(std::move(image));
+    stats_.record(Stage::kSerialize, t1 - t0);
+    stats_.record(Stage::kPublish, steadyNowNs() - t1);
+}
+
+// 주기가 안 됐으면 false. on-change 면 마지막으로 보낸 뒤 눈에 띄는 변화가 있거나 keepalive 가 지나야 true.
+bool CameraSession::outputDue(RateGate &gate, uint64_t nowNs, const OverlaySignature *sig) {
+    if (gate.periodNs > 0 && nowNs < gate.nextNs) return false;
+    if (sig != nullptr && gate.lastNs != 0) {
+        const OverlaySignature &prev = gate.sent;
+        const bool changed = sig->fire != prev.fire || sig->blobs != prev.blobs ||
+                             std::abs(sig->hotX - prev.hotX) > 2 || std::abs(sig->hotY - prev.hotY) > 2 ||
+                             std::abs(sig->hotC - prev.hotC) >= opts_.imageChangeC;
+        const bool keepalive =
+            opts_.imageKeepaliveS > 0.0 && nowNs - gate.lastNs >= (uint64_t)(opts_.imageKeepaliveS * 1e9);
+        if (!changed && !keepalive) return false;
+    }
+    if (sig != nullptr) gate.sent = *sig;
+    if (gate.periodNs > 0) {
+        gate.nextNs = (gate.nextNs != 0 && nowNs - gate.nextNs < gate.periodNs) ? gate.nextNs + gate.periodNs
+                                                                                  : nowNs + gate.periodNs;
+    }
+    gate.lastNs = nowNs;
+    return true;
+}
+
+// ---- 영상/온도 짝짓기 ----
+// 새 온도 프레임이 있으면 이력으로 옮기고 true. 링 슬롯 버퍼와 이력 버퍼를 바꿔 끼우므로 복사가 없다.
+bool CameraSession::drainTemp() {
+    infiray::FrameSlot<uint16_t> *slot = tempRing_.acquireLatestMutable();
+    if (slot == nullptr) return false;
+    tempHead_ = (tempHead_ + 1) % tempHistory_.size();
+    TempEntry &e = tempHistory_[tempHead_];
+    e.data.swap(slot->data);
+    e.seq = slot->seq;
+    e.captureNs = slot->captureNs;
+    e.width = slot->width;
+    e.height = slot->height;
+    return true;
+}
+
+const CameraSession::TempEntry *CameraSession::newestTemp() const {
+    const TempEntry &e = tempHistory_[tempHead_];
+    return e.seq > 0 ? &e : nullptr;
+}
+
+// 캡처 시각이 가장 가까운 온도 프레임. 허용 차이 밖이면 nullptr.
+const CameraSession::TempEntry *CameraSession::pairTemp(uint64_t videoNs) const {
+    const TempEntry *best = nullptr;
+    uint64_t bestDiff = UINT64_MAX;
+    for (const auto &e : tempHistory_) {
+        if (e.seq == 0) continue;
+        const uint64_t diff = e.captureNs > videoNs ? e.captureNs - videoNs : videoNs - e.captureNs;
+        if (diff < bestDiff) {
+            bestDiff = diff;
+            best = &e;
+        }
+    }
+    const uint64_t tolNs = (uint64_t)(std::max(0.0, opts_.syncToleranceMs) * 1e6);
+    return best != nullptr && bestDiff <= tolNs ? best : nullptr;
+}
+
+std_msgs::msg::Header CameraSession::captureHeader(uint64_t captureNs, const rclcpp::Time &rosNow,
+                                                   uint64_t steadyNow) const {
+    std_msgs::msg::Header header;
+    const int64_t ageNs = steadyNow > captureNs ? (int64_t)(steadyNow - captureNs) : 0;
+    header.stamp = rosNow - rclcpp::Duration::from_nanoseconds(ageNs);
+    header.frame_id = frameId_;
+    return header;
+}
+
+// 온도 프레임의 고온 창. 적분 영상은 프레임당 한 번만 만들고 모든 창 크기가 공유한다.
+void CameraSession::findHotspots(const TempEntry &temp, std::vector<infiray::Hotspot> &out) {
+    const uint64_t t0 = steadyNowNs();
+    out.clear();
+    hotspotEngine_.build(temp.data.data(), temp.width, temp.height);
+    for (int size : opts_.hotspotSizes) {
+        const size_t base = out.size();
+        out.resize(base + opts_.hotspotTopK);
+        const int n = hotspotEngine_.topK(size, size, opts_.hotspotTopK, &out[base]);
+        out.resize(base + n);
+    }
+    stats_.record(Stage::kHotspot, steadyNowNs() - t0);
+}
+
+// ---- 경보 경로: 새 온도 프레임마다 바로 분석하고 발행한다 (영상 짝짓기를 기다리지 않음) ----
+// raw/fire_mask 발행이 있으면 job 에 채우고 true.
+bool CameraSession::analyzeTemp(const TempEntry &temp, OutputJob &job) {
+    const int localW = temp.width;
+    const int localH = temp.height;
+    if (localW <= 0 || localH <= 0 || temp.data.size() != (size_t)localW * localH) return false;
+    analyzedTempSeq_ = temp.seq;
+
+    // 표시용 Y 밝기(AGC)가 아니라 실제 온도 맵에서 가장 뜨거운 창을 찾는다
+    findHotspots(temp, hotspots_);
+
+    // 화재 판정은 온도 프레임마다 한 번 (픽셀별 기준선/상승 속도/연속 횟수 상태 갱신)
+    uint64_t t0 = steadyNowNs();
+    fireDetector_.update(temp.data.data(), localW, localH, temp.captureNs);
+    stats_.record(Stage::kFire, steadyNowNs() - t0);
+    const bool newFire = fireDetector_.width() == localW && fireDetector_.height() == localH;
+    const infiray::FireResult &fire = fireDetector_.result();
+
+    // 고온 덩어리 분할 + 추적 (ID 유지)
+    if (opts_.blobsEnabled) {
+        t0 = steadyNowNs();
+        blobTracker_.update(temp.data.data(), localW, localH, temp.captureNs);
+        stats_.record(Stage::kBlobs, steadyNowNs() - t0);
+    }
+    // 전체/ROI 통계: 온도 맵 한 번 순회
+    if (opts_.statsEnabled) {
+        t0 = steadyNowNs();
+        statsEngine_.update(temp.data.data(), localW, localH);
+        stats_.record(Stage::kStats, steadyNowNs() - t0);
+    }
+    const infiray::Hotspot hot = hotspots_.empty() ? infiray::Hotspot{} : hotspots_.front();
+    const bool isTempValid = hot.valid;
+
+    // 헤더에는 발행 시각이 아니라 온도 프레임의 캡처 시각을 싣는다
+    const std_msgs::msg::Header header = captureHeader(temp.captureNs, node_.now(), steadyNowNs());
+    publishHotspots(header);
+    if (opts_.blobsEnabled) publishBlobs(header, blobTracker_.visible());
+    if (opts_.statsEnabled) publishStats(header);
+    publishScalar<std_msgs::msg::Float32>(temp_pub_, isTempValid ? hot.celsius : 0.0);
+    publishScalar<std_msgs::msg::Bool>(fire_pub_, fire.detected);
+    publishScalar<std_msgs::msg::Float32>(fire_conf_pub_, fire.confidence);
+    stats_.record(Stage::kCaptureToAlarm, steadyNowNs() - temp.captureNs);
+
+    // 같은 호스트 소비자에게는 DDS 없이 온도 맵을 그대로 (경보 발행 뒤라 경보 지연에는 영향 없음)
+    if (opts_.shmEnabled) {
+        shmTemp_.write(infiray::kShmTempRaw, localW, localH, localW * sizeof(uint16_t), temp.data.data(),
+                       localW * sizeof(uint16_t), temp.captureNs);
+    }
+
+    // raw/fire_mask 는 출력 단계에서 발행한다. 이력 버퍼는 곧 재사용되므로 풀 버퍼로 한 번 복사한다.
+    const bool wantRaw = opts_.publishRaw && outputDue(rawGate_, temp.captureNs, nullptr);
+    const bool wantMask = opts_.publishFireMask && newFire;
+    if (!wantRaw && !wantMask) return false;
+    job.tempHeader = header;
+    if (wantRaw) {
+        job.raw = acquirePooled(rawPool_, localW, localH, CV_16UC1);
+        std::memcpy(job.raw.data, temp.data.data(), (size_t)localW * localH * sizeof(uint16_t));
+    }
+    if (wantMask) {
+        job.fireMask = acquirePooled(maskPool_, localW, localH, CV_8UC1);
+        std::memcpy(job.fireMask.data, fireDetector_.mask(), (size_t)localW * localH);
+        job.publishMask = true;
+    }
+    return true;
+}
+
+// ---- 영상 경로: 짝지은 온도 프레임으로 오버레이/이미지 출력을 만든다 ----
+// temp 가 nullptr 이면 허용 차이 안에 온도 프레임이 없던 영상. 이미지를 내보내면 job 에 채우고 true.
+bool CameraSession::emitVideo(const infiray::FrameSlot<uint8_t> &frame, const TempEntry *temp, OutputJob &job) {
+    const int localW = frame.width;
+    const int localH = frame.height;
+    if (temp != nullptr && (temp->width != localW || temp->height != localH)) temp = nullptr;
+    if (temp != nullptr) {
+        const uint64_t diff = temp->captureNs > frame.captureNs ? temp->captureNs - frame.captureNs
+                                                               : frame.captureNs - temp->captureNs;
+        stats_.record(Stage::kPairOffset, diff);
+    } else {
+        unpaired_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 화면과 공유 메모리는 같은 호스트라 싸므로 매 프레임, DDS 로 나가는 오버레이는 rate.* 에 따른다
+    const bool wantLocal = opts_.showDisplay || opts_.shmEnabled;
+    const infiray::FireResult &fire = fireDetector_.result();
+    const infiray::Hotspot hot = hotspots_.empty() ? infiray::Hotspot{} : hotspots_.front();
+    const uint64_t nowNs = frame.captureNs;
+    OverlaySignature sig;
+    sig.fire = fire.detected;
+    sig.hotX = hot.x;
+    sig.hotY = hot.y;
+    sig.hotC = hot.valid ? (float)hot.celsius : 0.0f;
+    sig.blobs = opts_.blobsEnabled ? blobTracker_.visible().size() : 0;
+    const OverlaySignature *change = opts_.imageOnChange ? &sig : nullptr;
+    const bool sendOverlay = opts_.publishOverlay && outputDue(imageGate_, nowNs, change);
+    const bool sendEncoded = !encodeExt_.empty() && outputDue(compressedGate_, nowNs, change);
+    if (!sendOverlay && !sendEncoded && !wantLocal) {
+        // 이번 프레임에 내보낼 출력이 없으면 복사/렌더/인코딩 모두 건너뛴다
+        if (opts_.publishOverlay || !encodeExt_.empty()) renderSkipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    job.header = captureHeader(frame.captureNs, node_.now(), steadyNowNs());
+    job.captureNs = frame.captureNs;
+    job.publishOverlay = sendOverlay;
+    job.encode = sendEncoded;
+    if (temp != nullptr) {
+        // 짝이 없는 영상에는 다른 시각의 온도 표시를 겹치지 않는다.
+        // 짝이 가장 최근 분석한 온도면 그 결과를 그대로, 더 이전 것이면 고온 창만 그 프레임으로 다시 구한다.
+        if (temp->seq == analyzedTempSeq_) {
+            job.hotspots = hotspots_;
+            if (opts_.blobsEnabled) job.blobs = blobTracker_.visible();
+            if (fire.firePixels > 0 && fireDetector_.width() == localW && fireDetector_.height() == localH) {
+                if (job.fireMask.empty()) {
+                    job.fireMask = acquirePooled(maskPool_, localW, localH, CV_8UC1);
+                    std::memcpy(job.fireMask.data, fireDetector_.mask(), (size_t)localW * localH);
+                }
+                job.drawMask = true;
+            }
+        } else {
+            findHotspots(*temp, overlayHotspots_);
+            job.hotspots = overlayHotspots_;
+        }
+    }
+    // 링 슬롯/이력 버퍼는 곧 재사용되므로 풀 버퍼로 한 번 복사한다
+    if (temp != nullptr && !opts_.renderTempRangeC.empty()) {
+        // 온도 범위 고정 컬러: Y 대신 짝지은 온도 raw 를 바탕으로 (같은 프레임의 raw 발행용 복사가 있으면 같이 쓴다)
+        if (!job.raw.empty() && temp->seq == analyzedTempSeq_) {
+            job.temp = job.raw;
+        } else {
+            job.temp = acquirePooled(rawPool_, localW, localH, CV_16UC1);
+            std::memcpy(job.temp.data, temp->data.data(), (size_t)localW * localH * sizeof(uint16_t));
+        }
+    } else {
+        job.y = acquirePooled(yPool_, localW, localH, CV_8UC1);
+        std::memcpy(job.y.data, frame.data.data(), (size_t)localW * localH);
+    }
+    return true;
+}
+
+// ---- 분석 단계: 센서 속도로 고온 영역과 경보를 낸다 ----
+void CameraSession::analyticsLoop() {
+    const uint64_t tolNs = (uint64_t)(std::max(0.0, opts_.syncToleranceMs) * 1e6);
+
+    tempHistory_.assign((size_t)std::max(2, opts_.syncHistory), TempEntry{});
+    for (auto &e : tempHistory_) e.data.reserve(kMaxPixels);  // 링 슬롯과 같은 예약 (바꿔 껴도 재할당 없음)
+    tempHead_ = 0;
+
+    // 짝이 될 온도 프레임을 기다리는 영상 (슬롯은 다음 acquireLatest 까지 이 스레드가 가진다)
+    const infiray::FrameSlot<uint8_t> *pending = nullptr;
+    while (rclcpp::ok() && running_.load()) {
+        {
+            auto ready = [this] {
+                return yuvRing_.hasNew() || tempRing_.hasNew() || !running_.load() || !rclcpp::ok() ||
+                       source_->finished();
+            };
+            std::unique_lock<std::mutex> lk(wakeMtx_);
+            if (pending != nullptr) {
+                wakeCv_.wait_until(lk,
+                                   std::chrono::steady_clock::time_point(
+                                       std::chrono::nanoseconds(pending->captureNs + tolNs)),
+                                   ready);
+            } else {
+                wakeCv_.wait(lk, ready);
+            }
+        }
+        if (!running_.load() || !rclcpp::ok()) break;
+        // 재생/합성 소스가 끝났어도 링에 남은 프레임과 짝을 기다리던 영상까지 처리하고 나간다.
+        // 소스는 마지막 프레임을 링에 넣은 뒤에 finished 를 세우므로 먼저 읽어 두면 이번 회차에 모두 보인다.
+        const bool sourceDone = source_->finished();
+
+        OutputJob job;
+        bool haveJob = false;
+
+        // 가장 새 온도 프레임으로 경보를 낸다 (그 사이 덮어쓴 프레임은 링에서 집계)
+        if (drainTemp()) haveJob = analyzeTemp(*newestTemp(), job);
+
+        // 새 영상이 오면 아직 짝을 못 찾은 이전 영상은 짝 없이 버린다 (어차피 더 새 프레임이 나간다)
+        if (yuvRing_.hasNew()) {
+            if (pending != nullptr) unpaired_.fetch_add(1, std::memory_order_relaxed);
+            pending = yuvRing_.acquireLatest();
+            if (pending != nullptr && (pending->width <= 0 || pending->height <= 0 ||
+                                       pending->data.size() < (size_t)pending->width * pending->height)) {
+                pending = nullptr;
+            }
+        }
+
+        // 캡처 시각이 가장 가까운 온도 프레임과 짝짓는다. 가장 새 온도가 이 영상보다 앞서 찍힌 것이면
+        // 짝이 될 다음 온도 프레임을 허용 차이만큼만 기다린다 (그동안에도 경보는 위에서 바로 나간다).
+        if (pending != nullptr) {
+            const TempEntry *temp = pairTemp(pending->captureNs);
+            const TempEntry *newest = newestTemp();
+            const bool noLater = newest != nullptr && newest->captureNs >= pending->captureNs;
+            if (temp != nullptr || noLater || sourceDone || steadyNowNs() >= pending->captureNs + tolNs) {
+                haveJob = emitVideo(*pending, temp, job) || haveJob;
+                pending = nullptr;
+            }
+        }
+        if (haveJob) outputQueue_.push(std::move(job));
+        if (sourceDone && !yuvRing_.hasNew() && !tempRing_.hasNew()) break;
+    }
+
+    // 이 세션만 내린다 (다른 카메라와 같은 컨테이너의 컴포넌트는 계속 돈다). 스레드 join 은 stop() 에서.
+    running_.store(false);
+    outputQueue_.close();
+    source_->stop();
+
+    // ESC(화면 단계) 또는 재생 종료
+    const bool userQuit = userQuit_.load();
+    if (onExit_ && (userQuit || source_->finished())) onExit_(*this, userQuit);
+}
+
+// 글자는 자기 영역(dirty rect) 안에만 그린다 (프레임 전체가 아니라 그 부분 뷰에 putText)
+static void drawLabel(cv::Mat &dst, const char *text, cv::Point org, double fontScale, const cv::Scalar &color) {
+    int baseline = 0;
+    const cv::Size size = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX, fontScale, 1, &baseline);
+    const cv::Rect box = cv::Rect(org.x, org.y - size.height - 1, size.width + 2, size.height + baseline + 2) &
+                         cv::Rect(0, 0, dst.cols, dst.rows);
+    if (box.empty()) return;
+    cv::Mat view = dst(box);
+    cv::putText(view, text, org - box.tl(), cv::FONT_HERSHEY_SIMPLEX, fontScale, color, 1);
+}
+
+cv::Mat CameraSession::renderOverlay(const OutputJob &job) {
+    const infiray::Hotspot hot = job.hotspots.empty() ? infiray::Hotspot{} : job.hotspots.front();
+
+    // [수정점 2] 불필요한 이미지 확대(Resize) 제거하여 데이터 전송량 감소
+    // 구독자가 아직 참조 중인 버퍼에는 그리지 않도록 풀에서 빈 버퍼를 받는다
+    const cv::Mat &base = job.temp.empty() ? job.y : job.temp;
+    cv::Mat displayMat = acquirePooled(renderPool_, base.cols, base.rows, CV_8UC3);
+
+    // 팔레트 LUT + 화재 픽셀(빨간색)을 한 번에: 입력 한 번 읽고 출력 한 번 쓴다
+    const int paletteIndex = paletteIndex_.load(std::memory_order_relaxed);
+    const infiray::Palette8 &palette = palettes_[paletteIndex];
+    const uint8_t *mask = job.drawMask ? job.fireMask.data : nullptr;
+    const size_t maskStride = job.drawMask ? job.fireMask.step : 0;
+    const uint32_t fireBgr = infiray::packBgr(0, 0, 255);
+    if (!job.temp.empty()) {
+        if (paletteRawIndex_ != paletteIndex) {
+            infiray::buildRawPalette(palette, infiray::celsiusTable<TempDevice>(), TempDevice::kRawLevels,
+                                     (float)opts_.renderTempRangeC[0], (float)opts_.renderTempRangeC[1],
+                                     paletteRaw_);
+            paletteRawIndex_ = paletteIndex;
+        }
+        infiray::renderPaletteRaw(job.temp.ptr<uint16_t>(), job.temp.step, base.cols, base.rows, paletteRaw_, mask,
+                                  maskStride, fireBgr, displayMat.data, displayMat.step);
+    } else {
+        infiray::renderPalette8(job.y.data, job.y.step, base.cols, base.rows, palette, mask, maskStride, fireBgr,
+                                displayMat.data, displayMat.step);
+    }
+
+    // 이하 오버레이는 각자의 사각형 안만 건드린다 (전체 프레임 패스 없음)
+    // 추적 중인 덩어리: 노란 외접 사각형 + ID
+    for (const auto &b : job.blobs) {
+        const cv::Rect box(b.x, b.y, b.w, b.h);
+        cv::rectangle(displayMat, box, cv::Scalar(0, 255, 255), 1);
+        char idBuf[16];
+        snprintf(idBuf, sizeof(idBuf), "#%u", b.id);
+        drawLabel(displayMat, idBuf, cv::Point(box.x, std::max(10, box.y - 3)), 0.35, cv::Scalar(0, 255, 255));
+    }
+
+    // 확대 비율(scale) 제거로 좌표 원복
+    cv::Rect hotZone(hot.x, hot.y, hot.w, hot.h);
+    for (size_t i = 0; i < job.hotspots.size(); i++) {
+        const auto &h = job.hotspots[i];
+        cv::Rect zone(h.x, h.y, h.w, h.h);
+        cv::rectangle(displayMat, zone, cv::Scalar(0, 255, 0), i == 0 ? 2 : 1);
+        if (i > 0) {
+            char subBuf[32];
+            snprintf(subBuf, sizeof(subBuf), "%.1f C", h.celsius);
+            drawLabel(displayMat, subBuf, cv::Point(zone.x, zone.y + zone.height + 12), 0.35,
+                      cv::Scalar(0, 255, 0));
+        }
+    }
+
+    char textBuf[64];
+    if (hot.valid) {
+        snprintf(textBuf, sizeof(textBuf), "Max: %.1f C", hot.celsius);
+    } else {
+        snprintf(textBuf, sizeof(textBuf), "Wait...");
+    }
+
+    cv::Point textLoc(hotZone.x, hotZone.y - 10);
+    if (textLoc.y < 20) textLoc.y = hotZone.y + hotZone.height + 25;
+    // 폰트 크기 약간 축소 (원본 해상도에 맞춤)
+    drawLabel(displayMat, textBuf, textLoc, 0.4, cv::Scalar(0, 255, 0));
+    return displayMat;
+}
+
+// ---- 출력 단계: 이미지 발행 (DDS 가 느려도 분석 단계는 영향 없음) ----
+void CameraSession::outputLoop() {
+    OutputJob job;
+    while (outputQueue_.pop(job)) {
+        if (!job.raw.empty()) publishRaw(job.tempHeader, job.raw);
+        if (job.publishMask) publishImage(fire_mask_pub_, job.tempHeader, job.fireMask, "mono8");
+        if (job.y.empty() && job.temp.empty()) continue;
+
+        const uint64_t t0 = steadyNowNs();
+        cv::Mat displayMat = renderOverlay(job);
+        const uint64_t t1 = steadyNowNs();
+        stats_.record(Stage::kRender, t1 - t0);
+        if (job.publishOverlay) {
+            // cv_bridge 변환/복사 없이 Mat 을 그대로 넘긴다
+            auto image = std::make_unique<ImageContainer>(displayMat, job.header, false, "bgr8");
+            const uint64_t t2 = steadyNowNs();
+            image_pub_->publish(std::move(image));
+            const uint64_t t3 = steadyNowNs();
+            stats_.record(Stage::kSerialize, t2 - t1);
+            stats_.record(Stage::kPublish, t3 - t2);
+            stats_.record(Stage::kCaptureToImage, t3 - job.captureNs);
+        }
+        if (opts_.shmEnabled) {
+            shmImage_.write(infiray::kShmBgr8, displayMat.cols, displayMat.rows, displayMat.cols * 3, displayMat.data,
+                            displayMat.step, job.captureNs);
+        }
+        if (opts_.showDisplay) displayQueue_.push(displayMat);
+        if (job.encode) encodeQueue_.push(EncodeJob{job.header, displayMat});
+
+        // 다음 프레임을 기다리는 동안 풀 버퍼 참조를 잡고 있지 않도록
+        job = OutputJob{};
+    }
+    displayQueue_.close();
+    encodeQueue_.close();
+}
+
+// ---- 인코더 단계: 무선 링크용 압축 (출력/분석 단계는 기다리지 않는다) ----
+void CameraSession::encoderLoop() {
+    EncodeJob job;
+    while (encodeQueue_.pop(job)) {
+        const uint64_t t0 = steadyNowNs();
+        // 메시지의 data 버퍼에 바로 인코딩한다 (용량은 프레임 간 유지)
+        const bool ok = cv::imencode(encodeExt_, job.bgr, compressedMsg_.data, encodeParams_);
+        job.bgr.release();
+        const uint64_t t1 = steadyNowNs();
+        stats_.record(Stage::kEncode, t1 - t0);
+        if (!ok) continue;
+
+        compressedMsg_.header = job.header;
+        compressed_pub_->publish(compressedMsg_);
+        stats_.record(Stage::kPublish, steadyNowNs() - t1);
+        encodedBytes_.fetch_add(compressedMsg_.data.size(), std::memory_order_relaxed);
+    }
+}
+
+// ---- 계측 수집 ----
+diagnostic_msgs::msg::DiagnosticStatus CameraSession::collectDiagnostics(double periodS, std::FILE *csv,
+                                                                         uint64_t stampNs) {
+    using diagnostic_msgs::msg::DiagnosticStatus;
+    using diagnostic_msgs::msg::KeyValue;
+
+    DiagnosticStatus status;
+    status.name = "thermal_camera/" + (name_.empty() ? std::string("camera") : name_) + ": pipeline";
+    status.hardware_id = frameId_;
+
+    auto add = [&status](const std::string &key, const std::string &value) {
+        KeyValue kv;
+        kv.key = key;
+        kv.value = value;
+        status.values.push_back(std::move(kv));
+    };
+    auto fmt = [](const char *f, double v) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), f, v);
+        return std::string(buf);
+    };
+
+    // 구간 카운터 (링/큐는 누적값만 주므로 직전 값과의 차이)
+    Counters now;
+    now.video = yuvRing_.published();
+    now.temp = tempRing_.published();
+    now.videoOverwritten = yuvRing_.overwritten();
+    now.tempOverwritten = tempRing_.overwritten();
+    now.outputDropped = outputQueue_.dropped();
+    now.displayDropped = displayQueue_.dropped();
+    now.encodeDropped = encodeQueue_.dropped();
+    now.encodedBytes = encodedBytes_.load(std::memory_order_relaxed);
+    now.recordDropped = recorder_.dropped();
+    now.recordBytes = recorder_.bytesWritten();
+    now.renderSkipped = renderSkipped_.load(std::memory_order_relaxed);
+    now.unpaired = unpaired_.load(std::memory_order_relaxed);
+    now.videoCopyBytes = videoCopyBytes_.load(std::memory_order_relaxed);
+    const Counters &prev = lastCounters_;
+    const double period = periodS > 0.0 ? periodS : 1.0;
+
+    add("video_fps", fmt("%.1f", (now.video - prev.video) / period));
+    add("temp_fps", fmt("%.1f", (now.temp - prev.temp) / period));
+    // 분석 단계가 센서보다 느릴 때 링에서 덮어쓴 프레임
+    add("video_overwritten", std::to_string(now.videoOverwritten - prev.videoOverwritten));
+    add("temp_overwritten", std::to_string(now.tempOverwritten - prev.tempOverwritten));
+    // 발행/화면이 밀려 큐에서 버린 프레임
+    add("output_dropped", std::to_string(now.outputDropped - prev.outputDropped));
+    add("display_dropped", std::to_string(now.displayDropped - prev.displayDropped));
+    // rate.* / on-change 로 렌더를 건너뛴 프레임 (경보는 그대로 나갔다)
+    add("render_skipped", std::to_string(now.renderSkipped - prev.renderSkipped));
+    // sync.tolerance_ms 안에 온도 프레임이 없던 영상 프레임 (pair_offset 은 짝지은 프레임의 시각 차이)
+    add("unpaired", std::to_string(now.unpaired - prev.unpaired));
+    // 콜백 경로 메모리: 복사량과, 예약을 넘어 콜백에서 재할당한 누적 횟수 (soak 중 0 이어야 한다)
+    add("callback_copy_mbytes_per_s", fmt("%.1f", (now.videoCopyBytes - prev.videoCopyBytes) / period / 1e6));
+    add("callback_allocs", std::to_string(yuvRing_.grown() + tempRing_.grown()));
+    add("frame_buffer_allocs", std::to_string(infiray::frameAllocStats().allocations));
+    if (!encodeExt_.empty()) {
+        add("encode_dropped", std::to_string(now.encodeDropped - prev.encodeDropped));
+        add("compressed_kbytes_per_s", fmt("%.1f", (now.encodedBytes - prev.encodedBytes) / period / 1e3));
+    }
+    if (recording_.load(std::memory_order_relaxed)) {
+        add("record_dropped", std::to_string(now.recordDropped - prev.recordDropped));
+        add("record_mbytes_per_s", fmt("%.1f", (now.recordBytes - prev.recordBytes) / period / 1e6));
+    }
+    const bool analyticsBehind = now.videoOverwritten != prev.videoOverwritten;
+    lastCounters_ = now;
+
+    for (int i = 0; i < (int)Stage::kCount; i++) {
+        const Stage stage = (Stage)i;
+        const infiray::LatencySummary s = stats_.takeInterval(stage);
+        const std::string key = infiray::stageName(stage);
+        add(key + ".count", std::to_string(s.count));
+        if (s.count == 0) continue;
+        add(key + ".p50_us", fmt("%.1f", s.p50Ns / 1e3));
+        add(key + ".p99_us", fmt("%.1f", s.p99Ns / 1e3));
+        add(key + ".max_us", fmt("%.1f", s.maxNs / 1e3));
+        if (csv) {
+            std::fprintf(csv, "%llu,%s,%s,%llu,%.1f,%.1f,%.1f,%.1f,%.1f\n", (unsigned long long)stampNs,
+                         name_.c_str(), key.c_str(), (unsigned long long)s.count, s.meanNs / 1e3,
+                         s.p50Ns / 1e3, s.p90Ns / 1e3, s.p99Ns / 1e3, s.maxNs / 1e3);
+        }
+    }
+
+    status.level = analyticsBehind ? DiagnosticStatus::WARN : DiagnosticStatus::OK;
+    status.message = analyticsBehind ? "analytics behind sensor" : "ok";
+    return status;
+}
+
+// ---- 화면 단계: HighGUI 는 이 스레드에서만 부른다 ----
+void CameraSession::displayLoop() {
+    cv::namedWindow(windowName_, cv::WINDOW_NORMAL);
+    cv::resizeWindow(windowName_, 1280, 1024);
+
+    cv::Mat frame;
+    while (!displayQueue_.closed()) {
+        // 프레임이 없어도 창 이벤트와 키 입력은 계속 처리한다
+        if (displayQueue_.popFor(frame, std::chrono::milliseconds(30))) {
+            cv::imshow(windowName_, frame);
+            frame.release();
+        }
+        int key = cv::waitKey(1);
+        if (key == 27) {
+            userQuit_.store(true);
+            running_.store(false);
+            wakeWorker();
+            break;
+        } else if (key >= '1' && key < '1' + (int)palettes_.size()) {
+            paletteIndex_.store(key - '1');  // 1: 회색, 2: inferno, ... (kPaletteNames 순서)
+        }
+    }
+
+    cv::destroyWindow(windowName_);
+}
+
+}  // namespace infiray_ros2
@@ -0,0 +1,98 @@
+#include "infiray_ros2/fire_detector.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "infiray_ros2/temp_codec.hpp"
+
+namespace infiray {
+
+static inline float rawToCelsiusF(uint16_t raw) {
+    return (float)rawToKelvin30(raw) * (1.0f / 30.0f) - (float)RawConversionB::kelvin;
+}
+
+const FireResult &FireDetector::update(const uint16_t *temp, int width, int height, uint64_t captureNs) {
+    result_ = FireResult{};
+    if (temp == nullptr || width <= 0 || height <= 0) return result_;
+    const size_t n = (size_t)width * height;
+
+    // 첫 프레임 또는 해상도 변경: 현재 온도로 기준선을 시작한다
+    if (width != width_ || height != height_) {
+        width_ = width;
+        height_ = height;
+        smooth_.resize(n);
+        baseline_.resize(n);
+        count_.assign(n, 0.0f);
+        fire_.assign(n, 0.0f);
+        mask_.assign(n, 0);
+        for (size_t i = 0; i < n; i++) smooth_[i] = baseline_[i] = rawToCelsiusF(temp[i]);
+        lastNs_ = captureNs;
+        return result_;
+    }
+
+    // 프레임 간격 (멈췄다 재개한 경우 등은 1 ms ~ 1 s 로 제한)
+    double dt = captureNs > lastNs_ ? (captureNs - lastNs_) * 1e-9 : 0.0;
+    lastNs_ = captureNs;
+    dt = std::clamp(dt, 1e-3, 1.0);
+
+    const float aSmooth = (float)(1.0 - std::exp(-dt / std::max(cfg_.smoothTauS, 1e-3)));
+    const float aBase = (float)(1.0 - std::exp(-dt / std::max(cfg_.baselineTauS, 1e-3)));
+    const float invDt = (float)(1.0 / dt);
+    const float onC = (float)cfg_.thresholdC;
+    const float offC = (float)cfg_.releaseC;
+    const float onDelta = (float)cfg_.riseDeltaC;
+    const float offDelta = (float)cfg_.riseDeltaReleaseC;
+    const float onRate = (float)cfg_.riseRateCps;
+    const float onN = (float)std::max(1, cfg_.onFrames);
+    const float offN = (float)std::max(1, cfg_.offFrames);
+
+    float *__restrict smooth = smooth_.data();
+    float *__restrict base = baseline_.data();
+    float *__restrict count = count_.data();
+    float *__restrict fire = fire_.data();
+
+    // 조건은 0/1 float 으로 만들고 곱/합으로만 섞는다 (분기가 있으면 벡터화되지 않는다)
+    int hotPixels = 0;
+    for (size_t i = 0; i < n; i++) {
+        const float c = rawToCelsiusF(temp[i]);
+        const float prev = smooth[i];
+        const float s = prev + aSmooth * (c - prev);
+        const float rate = (s - prev) * invDt;
+        const float excess = s - base[i];
+
+        const float hot = (s >= onC ? 1.0f : 0.0f) + (excess >= onDelta ? 1.0f : 0.0f) +
+                          (rate >= onRate ? 1.0f : 0.0f) > 0.5f ? 1.0f : 0.0f;
+        const float cool = (s < offC ? 1.0f : 0.0f) * (excess < offDelta ? 1.0f : 0.0f) *
+                           (rate < onRate ? 1.0f : 0.0f);
+        const float on = fire[i];
+        const float off = 1.0f - on;
+
+        // 정상 픽셀은 뜨거움 연속 횟수, 화재 픽셀은 해제 연속 횟수를 센다
+        const float advance = on * cool + off * hot;
+        const float cnt = advance * (count[i] + 1.0f);
+        const float flip = cnt >= on * offN + off * onN ? 1.0f : 0.0f;
+
+        fire[i] = on + flip - 2.0f * on * flip;
+        count[i] = cnt * (1.0f - flip);
+        smooth[i] = s;
+        // 기준선은 정상이고 뜨겁지 않은 픽셀만 따라간다 (불이 기준선에 흡수되지 않도록)
+        base[i] += off * (1.0f - hot) * aBase * (s - base[i]);
+        hotPixels += (int)hot;
+    }
+
+    int firePixels = 0;
+    uint8_t *mask = mask_.data();
+    for (size_t i = 0; i < n; i++) {
+        mask[i] = (uint8_t)(fire[i] * 255.0f);
+        firePixels += (int)fire[i];
+    }
+
+    const int minPixels = std::max(1, cfg_.minPixels);
+    result_.firePixels = firePixels;
+    result_.hotPixels = hotPixels;
+    result_.confidence = std::min(1.0f, (float)firePixels / (float)minPixels);
+    result_.detected = firePixels >= minPixels;
+    return result_;
+}
+
+}  // namespace infiray
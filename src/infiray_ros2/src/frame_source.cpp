@@ -0,0 +1,247 @@
+#include "infiray_ros2/frame_source.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#include "infiray_ros2/frame_record.hpp"
+#include "infiray_ros2/mmap_recorder.hpp"
+#include "infiray_ros2/temp_codec.hpp"
+
+namespace infiray {
+
+// ================= 합성 소스 =================
+
+SyntheticFrameSource::SyntheticFrameSource(const SyntheticSourceConfig &cfg) : cfg_(cfg) {
+    const size_t numPixels = (size_t)cfg_.width * cfg_.height;
+    temp_.resize(numPixels);
+    sdkTemp_.resize(numPixels * 2);
+    yuv_.resize(numPixels * 3 / 2);
+    // U/V 평면은 회색(128)으로 고정
+    std::fill(yuv_.begin() + numPixels, yuv_.end(), (uint8_t)128);
+
+    std::mt19937 rng(cfg_.seed);
+    std::uniform_real_distribution<double> ux(0.0, cfg_.width - 1);
+    std::uniform_real_distribution<double> uy(0.0, cfg_.height - 1);
+    std::uniform_real_distribution<double> uv(-3.0, 3.0);
+    std::uniform_real_distribution<double> up(0.6, 1.0);
+    for (int i = 0; i < cfg_.numBlobs; i++) {
+        double peak = cfg_.ambientC + (cfg_.blobPeakC - cfg_.ambientC) * up(rng);
+        blobs_.push_back({ux(rng), uy(rng), uv(rng), uv(rng), peak});
+    }
+}
+
+SyntheticFrameSource::~SyntheticFrameSource() { stop(); }
+
+void SyntheticFrameSource::renderFrame(long frameIndex) {
+    const int w = cfg_.width;
+    const int h = cfg_.height;
+    const uint16_t ambientRaw = celsiusToRaw(cfg_.ambientC);
+    std::fill(temp_.begin(), temp_.end(), ambientRaw);
+
+    const int R = std::max(1, cfg_.blobRadius * 2);
+    const double invR2 = 1.0 / ((double)R * R);
+    uint16_t maxRaw = ambientRaw;
+
+    for (auto &b : blobs_) {
+        if (frameIndex > 0) {
+            b.x += b.vx;
+            b.y += b.vy;
+            if (b.x < 0 || b.x >= w) { b.vx = -b.vx; b.x = std::clamp(b.x, 0.0, (double)(w - 1)); }
+            if (b.y < 0 || b.y >= h) { b.vy = -b.vy; b.y = std::clamp(b.y, 0.0, (double)(h - 1)); }
+        }
+
+        const int cx = (int)b.x, cy = (int)b.y;
+        const int x0 = std::max(0, cx - R), x1 = std::min(w - 1, cx + R);
+        const int y0 = std::max(0, cy - R), y1 = std::min(h - 1, cy + R);
+        for (int y = y0; y <= y1; y++) {
+            uint16_t *row = &temp_[(size_t)y * w];
+            const double dy = y - b.y;
+            for (int x = x0; x <= x1; x++) {
+                const double dx = x - b.x;
+                const double d2 = (dx * dx + dy * dy) * invR2;
+                if (d2 >= 1.0) continue;
+                // 가장자리로 갈수록 부드럽게 떨어지는 (1-d^2)^2 형태
+                const double wgt = (1.0 - d2) * (1.0 - d2);
+                const uint16_t raw = celsiusToRaw(cfg_.ambientC + (b.peakC - cfg_.ambientC) * wgt);
+                if (raw > row[x]) row[x] = raw;
+                if (raw > maxRaw) maxRaw = raw;
+            }
+        }
+    }
+
+    // Y 평면: 카메라 AGC 흉내 (ambient ~ max 를 0~255 로 선형 매핑)
+    const int span = std::max(1, (int)maxRaw - (int)ambientRaw);
+    uint8_t *yPlane = yuv_.data();
+    for (size_t i = 0; i < temp_.size(); i++) {
+        int v = ((int)temp_[i] - (int)ambientRaw) * 255 / span;
+        yPlane[i] = (uint8_t)std::clamp(v, 0, 255);
+    }
+
+    encodeTempB(temp_.data(), temp_.size(), sdkTemp_.data());
+}
+
+bool SyntheticFrameSource::start() {
+    if (running_.load()) return true;
+    if (cfg_.width <= 0 || cfg_.height <= 0) return false;
+    finished_.store(false);
+    running_.store(true);
+    thread_ = std::thread(&SyntheticFrameSource::run, this);
+    return true;
+}
+
+void SyntheticFrameSource::stop() {
+    running_.store(false);
+    if (thread_.joinable()) thread_.join();
+}
+
+void SyntheticFrameSource::run() {
+    using clock = std::chrono::steady_clock;
+    const bool throttle = cfg_.fps > 0.0;
+    const auto period = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(throttle ? 1.0 / cfg_.fps : 0.0));
+    auto next = clock::now();
+
+    for (long i = 0; running_.load(); i++) {
+        if (cfg_.maxFrames > 0 && i >= cfg_.maxFrames) break;
+        renderFrame(i);
+
+        if (tempCb_) tempCb_((char *)sdkTemp_.data(), (long)sdkTemp_.size(), context_);
+        if (videoCb_) videoCb_((char *)yuv_.data(), (long)yuv_.size(), cfg_.width, cfg_.height, context_);
+
+        if (throttle) {
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    }
+    markFinished();
+}
+
+// ================= 재생 소스 =================
+
+ReplayFrameSource::ReplayFrameSource(const ReplaySourceConfig &cfg) : cfg_(cfg) {}
+
+ReplayFrameSource::~ReplayFrameSource() { stop(); }
+
+bool ReplayFrameSource::start() {
+    if (running_.load()) return true;
+
+    // 파일 하나 또는 녹화기가 나눈 세그먼트 묶음 (run.irrec -> run_0000.irrec ...)
+    files_ = listRecordSegments(cfg_.path);
+    std::FILE *fp = files_.empty() ? nullptr : std::fopen(files_.front().c_str(), "rb");
+    if (!fp) {
+        std::cerr << "Replay: cannot open " << cfg_.path << "\n";
+        return false;
+    }
+    FileHeader fh;
+    bool ok = std::fread(&fh, sizeof(fh), 1, fp) == 1 &&
+              std::memcmp(fh.magic, kRecordFileMagic, sizeof(fh.magic)) == 0;
+    std::fclose(fp);
+    if (!ok) {
+        std::cerr << "Replay: not an .irrec file: " << files_.front() << "\n";
+        return false;
+    }
+
+    finished_.store(false);
+    running_.store(true);
+    thread_ = std::thread(&ReplayFrameSource::run, this);
+    return true;
+}
+
+void ReplayFrameSource::stop() {
+    running_.store(false);
+    if (thread_.joinable()) thread_.join();
+}
+
+void ReplayFrameSource::run() {
+    using clock = std::chrono::steady_clock;
+
+    std::FILE *fp = nullptr;
+    size_t fileIdx = 0;
+    auto openFile = [&](size_t i) {
+        if (fp) std::fclose(fp);
+        fp = std::fopen(files_[i].c_str(), "rb");
+        if (fp) std::fseek(fp, sizeof(FileHeader), SEEK_SET);
+        return fp != nullptr;
+    };
+    if (!openFile(0)) {
+        markFinished();
+        return;
+    }
+
+    std::vector<uint8_t> video, temp, yuv, sdkTemp;
+    bool haveBase = false;
+    uint64_t baseNs = 0;
+    clock::time_point startTime;
+
+    long recordsThisPass = 0;
+    // 세그먼트가 끝나면 다음 세그먼트로 (시각 기준은 이어 간다), 마지막이면 처음으로
+    auto advance = [&]() {
+        if (fileIdx + 1 < files_.size()) return openFile(++fileIdx);
+        haveBase = false;
+        // 레코드가 하나도 없는 파일을 무한 반복하지 않도록
+        bool again = cfg_.loop && recordsThisPass > 0;
+        recordsThisPass = 0;
+        fileIdx = 0;
+        return again && openFile(0);
+    };
+
+    while (running_.load()) {
+        RecordHeader rh;
+        if (std::fread(&rh, sizeof(rh), 1, fp) != 1 || rh.magic != kRecordMagic) {
+            if (!advance()) break;
+            continue;
+        }
+
+        video.resize(rh.videoBytes);
+        temp.resize(rh.tempBytes);
+        if ((rh.videoBytes > 0 && std::fread(video.data(), 1, rh.videoBytes, fp) != rh.videoBytes) ||
+            (rh.tempBytes > 0 && std::fread(temp.data(), 1, rh.tempBytes, fp) != rh.tempBytes)) {
+            if (!advance()) break;
+            continue;
+        }
+        recordsThisPass++;
+
+        if (cfg_.realtime) {
+            if (!haveBase) {
+                haveBase = true;
+                baseNs = rh.captureNs;
+                startTime = clock::now();
+            } else if (rh.captureNs > baseNs) {
+                std::this_thread::sleep_until(startTime + std::chrono::nanoseconds(rh.captureNs - baseNs));
+            }
+        }
+
+        const size_t numPixels = (size_t)rh.width * rh.height;
+
+        if (rh.tempBytes > 0 && tempCb_) {
+            if (rh.tempFormat == kTempDecodedU16 && rh.tempBytes == numPixels * 2) {
+                sdkTemp.resize(numPixels * 2);
+                encodeTempB(reinterpret_cast<const uint16_t *>(temp.data()), numPixels, sdkTemp.data());
+                tempCb_((char *)sdkTemp.data(), (long)sdkTemp.size(), context_);
+            } else if (rh.tempFormat == kTempSdkB) {
+                tempCb_((char *)temp.data(), (long)temp.size(), context_);
+            }
+        }
+
+        if (rh.videoBytes > 0 && videoCb_) {
+            if (rh.videoFormat == kVideoYOnly && rh.videoBytes == numPixels) {
+                // SDK 는 항상 I420 을 주므로 U/V 를 채워서 넘긴다
+                yuv.resize(numPixels * 3 / 2);
+                std::memcpy(yuv.data(), video.data(), numPixels);
+                std::fill(yuv.begin() + numPixels, yuv.end(), (uint8_t)128);
+                videoCb_((char *)yuv.data(), (long)yuv.size(), (int)rh.width, (int)rh.height, context_);
+            } else if (rh.videoFormat == kVideoYuv420) {
+                videoCb_((char *)video.data(), (long)video.size(), (int)rh.width, (int)rh.height, context_);
+            }
+        }
+    }
+
+    if (fp) std::fclose(fp);
+    markFinished();
+}
+
+}  // namespace infiray
@@ -0,0 +1,153 @@
+#include "infiray_ros2/frame_stats.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "infiray_ros2/temp_codec.hpp"
+
+namespace infiray {
+
+// rawToKelvin30 범위 7000 ~ 26166
+static constexpr int kBinBase = 7000;
+static constexpr int kBins = 26166 - kBinBase + 1;
+
+static inline float binToCelsius(double bin) { return (float)kelvin30ToCelsius(bin + kBinBase); }
+
+FrameStatsEngine::FrameStatsEngine() : binOf_(kRawLevels), frameHist_(kBins, 0) {
+    for (int r = 0; r < kRawLevels; r++) binOf_[r] = (uint16_t)(rawToKelvin30((uint16_t)r) - kBinBase);
+}
+
+void FrameStatsEngine::configure(const std::vector<StatsRoi> &rois, const std::vector<double> &percentiles) {
+    rois_.clear();
+    for (const auto &roi : rois) {
+        if (roi.xy.size() < 6 || roi.xy.size() % 2 != 0) {
+            std::cerr << "Stats ROI '" << roi.name << "' needs at least 3 x,y points (skipped)\n";
+            continue;
+        }
+        rois_.push_back(roi);
+    }
+    percentiles_.clear();
+    for (double p : percentiles) percentiles_.push_back(std::clamp(p, 0.0, 100.0));
+    std::sort(percentiles_.begin(), percentiles_.end());
+    ranks_.resize(percentiles_.size());
+
+    roiHist_.assign((size_t)kBins * rois_.size(), 0);
+    roiAcc_.assign(rois_.size(), Acc{});
+    roiStats_.assign(rois_.size(), RegionStats{});
+    width_ = height_ = 0;  // 다음 update 에서 다시 래스터화
+}
+
+// 픽셀 중심 (x + 0.5, y + 0.5) 이 다각형 안(짝홀 규칙)인 픽셀을 행 단위 run 으로
+void FrameStatsEngine::rasterize(int width, int height) {
+    width_ = width;
+    height_ = height;
+    segs_.clear();
+    rowStart_.assign((size_t)height + 1, 0);
+
+    for (int y = 0; y < height; y++) {
+        rowStart_[y] = (int)segs_.size();
+        const float yc = (float)y + 0.5f;
+        for (int r = 0; r < (int)rois_.size(); r++) {
+            const auto &xy = rois_[r].xy;
+            const size_t n = xy.size() / 2;
+            crossings_.clear();
+            for (size_t i = 0, j = n - 1; i < n; j = i++) {
+                const float xi = xy[2 * i], yi = xy[2 * i + 1];
+                const float xj = xy[2 * j], yj = xy[2 * j + 1];
+                if ((yi <= yc) == (yj <= yc)) continue;
+                crossings_.push_back(xi + (yc - yi) * (xj - xi) / (yj - yi));
+            }
+            std::sort(crossings_.begin(), crossings_.end());
+            for (size_t k = 0; k + 1 < crossings_.size(); k += 2) {
+                const int x0 = std::max(0, (int)std::ceil(crossings_[k] - 0.5f));
+                const int x1 = std::min(width, (int)std::ceil(crossings_[k + 1] - 0.5f));
+                if (x1 > x0) segs_.push_back({x0, x1, r});
+            }
+        }
+    }
+    rowStart_[height] = (int)segs_.size();
+
+    for (int r = 0; r < (int)rois_.size(); r++) {
+        size_t area = 0;
+        for (const auto &s : segs_) {
+            if (s.roi == r) area += (size_t)(s.x1 - s.x0);
+        }
+        if (area == 0) std::cerr << "Stats ROI '" << rois_[r].name << "' is outside the " << width << "x" << height
+                                 << " frame\n";
+    }
+}
+
+void FrameStatsEngine::update(const uint16_t *temp, int width, int height) {
+    if (temp == nullptr || width <= 0 || height <= 0) return;
+    if (width != width_ || height != height_) rasterize(width, height);
+
+    const uint16_t *bin = binOf_.data();
+    uint32_t *fh = frameHist_.data();
+    uint16_t flo = 0xFFFF, fhi = 0;
+    for (auto &a : roiAcc_) a = Acc{};
+
+    for (int y = 0; y < height; y++) {
+        const uint16_t *row = temp + (size_t)y * width;
+        for (int x = 0; x < width; x++) {
+            const uint16_t b = bin[clampRaw(row[x])];
+            fh[b]++;
+            flo = std::min(flo, b);
+            fhi = std::max(fhi, b);
+        }
+        // 방금 읽은 행이 캐시에 있을 때 이 행의 ROI run 을 처리한다
+        for (int s = rowStart_[y]; s < rowStart_[y + 1]; s++) {
+            const Segment &seg = segs_[s];
+            uint32_t *h = roiHist_.data() + (size_t)seg.roi * kBins;
+            Acc &acc = roiAcc_[seg.roi];
+            uint16_t lo = acc.lo, hi = acc.hi;
+            for (int x = seg.x0; x < seg.x1; x++) {
+                const uint16_t b = bin[clampRaw(row[x])];
+                h[b]++;
+                lo = std::min(lo, b);
+                hi = std::max(hi, b);
+            }
+            acc.lo = lo;
+            acc.hi = hi;
+            acc.pixels += (uint32_t)(seg.x1 - seg.x0);
+        }
+    }
+
+    Acc frameAcc;
+    frameAcc.pixels = (uint32_t)((size_t)width * height);
+    frameAcc.lo = flo;
+    frameAcc.hi = fhi;
+    summarize(fh, frameAcc, frame_);
+    for (size_t r = 0; r < rois_.size(); r++) summarize(roiHist_.data() + r * kBins, roiAcc_[r], roiStats_[r]);
+}
+
+// [lo, hi] 칸만 훑어 평균/분위수를 구하고 다음 프레임을 위해 0 으로 되돌린다
+void FrameStatsEngine::summarize(uint32_t *hist, const Acc &acc, RegionStats &out) {
+    out.pixels = acc.pixels;
+    out.percentileCelsius.assign(percentiles_.size(), 0.0f);
+    if (acc.pixels == 0) {
+        out.minCelsius = out.maxCelsius = out.meanCelsius = 0.0f;
+        return;
+    }
+
+    // 분위수 p 는 누적 개수가 ceil(p/100 * n) 에 처음 닿는 칸 (0 이면 최솟값). percentiles_ 는 오름차순.
+    for (size_t i = 0; i < percentiles_.size(); i++) {
+        ranks_[i] = std::max<uint64_t>(1, (uint64_t)std::ceil(percentiles_[i] / 100.0 * acc.pixels));
+    }
+
+    uint64_t cum = 0, weighted = 0;
+    size_t next = 0;
+    for (int b = acc.lo; b <= acc.hi; b++) {
+        const uint32_t c = hist[b];
+        if (c == 0) continue;
+        cum += c;
+        weighted += (uint64_t)c * (uint64_t)b;
+        while (next < ranks_.size() && cum >= ranks_[next]) out.percentileCelsius[next++] = binToCelsius(b);
+        hist[b] = 0;
+    }
+    out.minCelsius = binToCelsius(acc.lo);
+    out.maxCelsius = binToCelsius(acc.hi);
+    out.meanCelsius = binToCelsius((double)weighted / (double)acc.pixels);
+}
+
+}  // namespace infiray
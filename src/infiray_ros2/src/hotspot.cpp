@@ -0,0 +1,94 @@
+#include "infiray_ros2/hotspot.hpp"
+
+#include <algorithm>
+
+#include "infiray_ros2/temp_codec.hpp"
+
+namespace infiray {
+
+void HotspotEngine::build(const uint16_t *temp, int width, int height) {
+    width_ = (temp != nullptr && width > 0 && height > 0) ? width : 0;
+    height_ = width_ > 0 ? height : 0;
+    if (width_ == 0) return;
+
+    const size_t stride = (size_t)width_ + 1;
+    sat_.resize(stride * (height_ + 1));
+    std::fill(sat_.begin(), sat_.begin() + stride, 0u);
+
+    for (int y = 0; y < height_; y++) {
+        const uint16_t *row = temp + (size_t)y * width_;
+        const uint32_t *prev = &sat_[(size_t)y * stride];
+        uint32_t *cur = &sat_[(size_t)(y + 1) * stride];
+
+        // 행 누적합은 순차, 윗행 더하기는 벡터화되도록 두 루프로 나눈다.
+        // 14비트를 넘는 raw 는 LUT/통계와 같이 최댓값으로 본다 (kMaxWindowArea 의 넘침 한계도 이 값 기준).
+        uint32_t run = 0;
+        cur[0] = 0;
+        for (int x = 0; x < width_; x++) {
+            run += (uint32_t)rawToKelvin30(clampRaw(row[x]));
+            cur[x + 1] = run;
+        }
+        for (size_t x = 1; x < stride; x++) cur[x] += prev[x];
+    }
+}
+
+int HotspotEngine::topK(int winW, int winH, int k, Hotspot *out) {
+    if (width_ == 0 || k <= 0 || out == nullptr) return 0;
+    winW = std::min(winW, width_);
+    winH = std::min(winH, height_);
+    if (winW <= 0 || winH <= 0 || (long)winW * winH > kMaxWindowArea) return 0;
+
+    const int nx = width_ - winW + 1;
+    const int ny = height_ - winH + 1;
+    windows_.resize((size_t)nx * ny);
+
+    const size_t stride = (size_t)width_ + 1;
+    rowMax_.resize(ny);
+    for (int y = 0; y < ny; y++) {
+        const uint32_t *top = &sat_[(size_t)y * stride];
+        const uint32_t *bot = &sat_[(size_t)(y + winH) * stride];
+        uint32_t *dst = &windows_[(size_t)y * nx];
+        uint32_t m = 0;
+        for (int x = 0; x < nx; x++) {
+            dst[x] = bot[x + winW] - bot[x] - top[x + winW] + top[x];
+            m = std::max(m, dst[x]);
+        }
+        rowMax_[y] = m;
+    }
+
+    // 창 합은 항상 7000*넓이 이상이므로 0 을 '억제됨' 표시로 쓴다.
+    // 행별 최댓값만 훑어 후보 행을 고르고, 억제 후에는 영향받은 행만 다시 계산한다.
+    const double area = (double)winW * winH;
+    int found = 0;
+    for (; found < k; found++) {
+        const int by = (int)(std::max_element(rowMax_.begin(), rowMax_.end()) - rowMax_.begin());
+        const uint32_t best = rowMax_[by];
+        if (best == 0) break;
+
+        const uint32_t *row = &windows_[(size_t)by * nx];
+        Hotspot &h = out[found];
+        h.valid = true;
+        h.x = (int)(std::find(row, row + nx, best) - row);
+        h.y = by;
+        h.w = winW;
+        h.h = winH;
+        h.celsius = kelvin30ToCelsius((double)best / area);
+
+        // 고른 창과 겹치는 모든 위치를 지운다
+        const int x0 = std::max(0, h.x - winW + 1), x1 = std::min(nx - 1, h.x + winW - 1);
+        const int y0 = std::max(0, h.y - winH + 1), y1 = std::min(ny - 1, h.y + winH - 1);
+        for (int y = y0; y <= y1; y++) {
+            uint32_t *r = &windows_[(size_t)y * nx];
+            std::fill(r + x0, r + x1 + 1, 0u);
+            rowMax_[y] = *std::max_element(r, r + nx);
+        }
+    }
+    return found;
+}
+
+double HotspotEngine::meanCelsius(int x, int y, int w, int h) const {
+    if (width_ == 0 || w <= 0 || h <= 0 || x < 0 || y < 0 || x + w > width_ || y + h > height_) return 0.0;
+    return kelvin30ToCelsius((double)boxSum(x, y, w, h) / ((double)w * h));
+}
+
+}  // namespace infiray
@@ -1,299 +1,243 @@
 #include <iostream>
-#include <cstring>
-#include <unistd.h>
 #include <vector>
 #include <string>
-#include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <algorithm>
-#include <cstdio> 
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
 
 #include <opencv2/opencv.hpp>
 
 // --- [ROS2 관련 헤더 추가] ---
 #include "rclcpp/rclcpp.hpp"
-#include "sensor_msgs/msg/image.hpp"
-#include "std_msgs/msg/float32.hpp"
-#include "std_msgs/msg/bool.hpp"
-#include "cv_bridge/cv_bridge.h"
+#include "std_msgs/msg/float64_multi_array.hpp"
+#include "diagnostic_msgs/msg/diagnostic_array.hpp"
+#include "rclcpp_components/register_node_macro.hpp"
 
 using namespace std;
 
-// --- [윈도우 호환용 매크로 정의] ---
-#ifndef _WIN32
-    #define __stdcall
-    #define CALLINGCONVEN
-    #define CNET_APIIMPORT
-    #define CALLBACK
-    #define WINAPI
-    typedef unsigned long DWORD;
-    typedef unsigned short WORD;
-    typedef unsigned char BYTE;
-    typedef long LPARAM;
-    typedef unsigned long WPARAM;
-    typedef int BOOL;
-    typedef unsigned int UINT;
-    typedef void* HWND;
-    typedef void* HANDLE;
-    typedef void* HDC;
-    typedef unsigned int COLORREF;
-    typedef long LONG;
-    typedef struct _RECT { LONG left; LONG top; LONG right; LONG bottom; } RECT;
-    #ifndef TRUE
-        #define TRUE 1
-    #endif
-    #ifndef FALSE
-        #define FALSE 0
-    #endif
-#endif
-
-#include "LinuxDef.h"
-#include "InfraredTempSDK.h"
-
-// ---- 프레임 더블 버퍼 (영상용) ----
-static std::mutex g_mtx;
-static std::condition_variable g_cv;
-static std::vector<uint8_t> g_yuvBuf[2];
-static int g_writeIdx = 0;
-static int g_readIdx  = 1;
-static int g_width = 0;
-static int g_height = 0;
-static std::atomic<bool> g_hasNewFrame{false};
-static std::atomic<bool> g_running{true};
-
-// ---- 온도 데이터 버퍼 ----
-static std::mutex g_tempMtx;
-static std::vector<uint16_t> g_tempBuf; 
-
-// ---- 영상 콜백 ----
-void videoCallBack(char *pBuffer, long BufferLen, int width, int height, void *pContext) {
-    const long expected = (long)(width * height * 3 / 2);
-    if (BufferLen != expected || pBuffer == nullptr) return;
-
-    {
-        std::lock_guard<std::mutex> lk(g_mtx);
-        g_width = width;
-        g_height = height;
-
-        auto &dst = g_yuvBuf[g_writeIdx];
-        if ((long)dst.size() != BufferLen) dst.resize(BufferLen);
-
-        std::memcpy(dst.data(), pBuffer, BufferLen);
-        std::swap(g_writeIdx, g_readIdx);
-        g_hasNewFrame.store(true, std::memory_order_release);
-    }
-    g_cv.notify_one();
-}
-
-// ---- 온도 데이터 콜백 ----
-void tempCallBack(char *pBuffer, long BufferLen, void* pContext) {
-    if (pBuffer == nullptr || BufferLen <= 0) return;
-    
-    int numPixels = BufferLen / 2; 
-
-    std::lock_guard<std::mutex> lk(g_tempMtx);
-    if (g_tempBuf.size() != (size_t)numPixels) {
-        g_tempBuf.resize(numPixels);
-    }
-    
-    uint8_t* temp_buffer = (uint8_t*)pBuffer;
-    for (int ii = 0; ii < numPixels / 2; ii++) {
-        g_tempBuf[ii * 2]     = (uint16_t)((temp_buffer[ii * 2] << 8)     + temp_buffer[ii * 2 + 1 + numPixels]);
-        g_tempBuf[ii * 2 + 1] = (uint16_t)((temp_buffer[ii * 2 + 1] << 8) + temp_buffer[ii * 2 + numPixels]);
-    }
-}
-
-int main(int argc, char** argv) {
-    rclcpp::init(argc, argv);
-    auto node = rclcpp::Node::make_shared("thermal_camera_node");
-
-    node->declare_parameter("show_display", false);
-    bool show_display = node->get_parameter("show_display").as_bool();
-
-    // [수정점 1] QoS 프로필을 SensorData (Best Effort)로 변경하여 네트워크 지연 방지
-    auto qos = rclcpp::SensorDataQoS();
-    auto image_pub = node->create_publisher<sensor_msgs::msg::Image>("/thermal/image", qos);
-    auto temp_pub = node->create_publisher<std_msgs::msg::Float32>("/thermal/max_temp", qos);
-    auto fire_pub = node->create_publisher<std_msgs::msg::Bool>("/thermal/fire_detected", qos);
-
-    std::cout << "Starting Thermal App (ROS2 Integrated)\n";
-    std::cout << "Local Display Mode: " << (show_display ? "ON" : "OFF") << "\n";
-
-    cv::setNumThreads(1);
-
-    int deviceType = 1; 
-    char username[] = "admin";
-    char password[] = "admin";
-
-    sdk_set_type(deviceType, username, password);
-    if (sdk_initialize() < 0) {
-        std::cerr << "SDK Init Failed\n";
-        rclcpp::shutdown();
-        return -1;
-    }
-
-    sleep(1);
-    IRNETHANDLE pHandle = sdk_create();
-
-    ChannelInfo devInfo;
-    memset(&devInfo, 0, sizeof(ChannelInfo));
-    strcpy(devInfo.szUserName, username);
-    strcpy(devInfo.szPWD, password);
-
-    const char* targetIP = "192.168.1.123";
-    strcpy(devInfo.szIP, targetIP);
-    devInfo.wPortNum = 3000;
-
-    if (sdk_loginDevice(pHandle, devInfo) != 0) {
-        std::cerr << "Login Failed\n";
-        sdk_release();
-        rclcpp::shutdown();
-        return -1;
-    }
-
-    SetDeviceVideoCallBack(pHandle, videoCallBack, nullptr);
-    SetTempCallBack(pHandle, tempCallBack, nullptr);
-    sdk_start_url(pHandle, devInfo.szIP);
-
-    if (show_display) {
-        cv::namedWindow("Thermal", cv::WINDOW_NORMAL);
-        cv::resizeWindow("Thermal", 1280, 1024);
-    }
-
-    int displayMode = 1;
-    cv::Mat displayMat;
-
-    while (rclcpp::ok() && g_running.load()) {
-        int localW = 0, localH = 0, localIdx = -1;
+#include "infiray_ros2/camera_session.hpp"
+#include "infiray_ros2/rt_tuning.hpp"
+#include "infiray_ros2/temp_codec.hpp"
+
+// ---- 노드 (rclcpp component) ----
+// 카메라별 상태(버퍼/스레드/토픽)는 CameraSession 이 갖고, 노드는 공통 설정과 수명만 관리한다.
+namespace infiray_ros2 {
+
+class ThermalCameraNode : public rclcpp::Node {
+public:
+    explicit ThermalCameraNode(const rclcpp::NodeOptions &options)
+        : rclcpp::Node("thermal_camera_node", rclcpp::NodeOptions(options).use_intra_process_comms(true)) {
+        SessionOptions opts;
+        opts.showDisplay = declare_parameter("show_display", false);
+        // 오버레이(bgr8) 렌더링/발행은 선택, 원시 온도(mono16)가 기본 데이터 경로
+        opts.publishOverlay = declare_parameter("publish_overlay", true);
+        opts.publishRaw = declare_parameter("publish_raw", true);
+
+        // 고온 창 크기(정사각, 픽셀)와 크기별 상위 K 개. 첫 크기의 1위가 max_temp 기준이다.
+        opts.hotspotSizes.clear();
+        for (int64_t size : declare_parameter("hotspot.window_sizes", std::vector<int64_t>{30})) {
+            if (size > 0) opts.hotspotSizes.push_back((int)size);
+        }
+        if (opts.hotspotSizes.empty()) opts.hotspotSizes.push_back(30);
+        opts.hotspotTopK = std::max<int64_t>(1, declare_parameter("hotspot.top_k", (int64_t)1));
+        // 픽셀 단위 화재 검출 (절대 온도 / 기준선 대비 상승폭 / 상승 속도 + 연속 프레임 히스테리시스)
+        auto &fire = opts.fire;
+        fire.thresholdC = declare_parameter("fire.threshold_c", fire.thresholdC);
+        fire.releaseC = declare_parameter("fire.release_c", fire.releaseC);
+        fire.riseDeltaC = declare_parameter("fire.rise_delta_c", fire.riseDeltaC);
+        fire.riseDeltaReleaseC = declare_parameter("fire.rise_delta_release_c", fire.riseDeltaReleaseC);
+        fire.riseRateCps = declare_parameter("fire.rise_rate_c_per_s", fire.riseRateCps);
+        fire.baselineTauS = declare_parameter("fire.baseline_tau_s", fire.baselineTauS);
+        fire.smoothTauS = declare_parameter("fire.smooth_tau_s", fire.smoothTauS);
+        fire.onFrames = declare_parameter("fire.on_frames", fire.onFrames);
+        fire.offFrames = declare_parameter("fire.off_frames", fire.offFrames);
+        fire.minPixels = declare_parameter("fire.min_pixels", fire.minPixels);
+        opts.publishFireMask = declare_parameter("fire.publish_mask", opts.publishFireMask);
+
+        // 오버레이 압축 발행 (/thermal/image/compressed). 무선 링크로 보는 UI 용.
+        opts.compressedFormat = declare_parameter("compressed.format", opts.compressedFormat);
+        opts.jpegQuality = declare_parameter("compressed.jpeg_quality", opts.jpegQuality);
+        opts.pngLevel = declare_parameter("compressed.png_level", opts.pngLevel);
+
+        // 고온 덩어리 분할 + 프레임 간 추적 (/thermal/blobs)
+        opts.blobsEnabled = declare_parameter("blobs.enabled", opts.blobsEnabled);
+        auto &blobs = opts.blobs;
+        blobs.thresholdC = declare_parameter("blobs.threshold_c", blobs.thresholdC);
+        blobs.minArea = declare_parameter("blobs.min_area", blobs.minArea);
+        blobs.maxBlobs = declare_parameter("blobs.max_count", blobs.maxBlobs);
+        blobs.maxMatchDistPx = declare_parameter("blobs.max_match_distance", blobs.maxMatchDistPx);
+        blobs.maxMissedFrames = declare_parameter("blobs.max_missed_frames", blobs.maxMissedFrames);
+        blobs.velocitySmoothing = declare_parameter("blobs.velocity_smoothing", blobs.velocitySmoothing);
+
+        // 전체/ROI 온도 통계 (/thermal/stats). ROI 다각형은 카메라별 stats.roi_names / stats.roi.<이름>.
+        opts.statsEnabled = declare_parameter("stats.enabled", opts.statsEnabled);
+        opts.statsPercentiles = declare_parameter("stats.percentiles", opts.statsPercentiles);
+
+        // 영상 콜백은 Y 평면만 링으로 복사한다 (false 면 YUV420 전체, U/V 를 쓰는 소비자가 생길 때)
+        opts.captureYOnly = declare_parameter("capture.y_only", opts.captureYOnly);
+
+        // 오버레이: 팔레트 (gray/inferno/jet/hot/magma/plasma/bone/rainbow) 와
+        // 온도 범위 고정 컬러 [최저, 최고] 섭씨 (비우면 영상 Y 를 칠한다)
+        opts.palette = declare_parameter("render.palette", opts.palette);
+        opts.renderTempRangeC = declare_parameter("render.temp_range_c", std::vector<double>{});
+        if (!opts.renderTempRangeC.empty() &&
+            (opts.renderTempRangeC.size() != 2 || opts.renderTempRangeC[1] <= opts.renderTempRangeC[0])) {
+            std::cerr << "render.temp_range_c needs [min, max] with min < max, using video Y\n";
+            opts.renderTempRangeC.clear();
+        }
 
-        {
-            std::unique_lock<std::mutex> lk(g_mtx);
-            g_cv.wait_for(lk, std::chrono::milliseconds(100), [] { 
-                return g_hasNewFrame.load(std::memory_order_acquire) || !g_running.load() || !rclcpp::ok(); 
-            });
-            
-            if (!g_running.load() || !rclcpp::ok()) break;
-            
-            if (g_hasNewFrame.load(std::memory_order_acquire)) {
-                localW = g_width;
-                localH = g_height;
-                localIdx = g_readIdx;
-                g_hasNewFrame.store(false, std::memory_order_release);
+        // 같은 호스트 소비자용 공유 메모리 링 (/dev/shm/infiray_<카메라>_temp, _image). 원격은 토픽 그대로.
+        opts.shmEnabled = declare_parameter("shm.enabled", opts.shmEnabled);
+        opts.shmSlots = std::max<int64_t>(2, declare_parameter("shm.slots", (int64_t)opts.shmSlots));
+
+        // 출력별 발행 주기 (0 이면 처리한 프레임마다). 차례가 아닌 프레임은 렌더/인코딩부터 건너뛴다.
+        // max_temp / fire_* / hotspots / blobs 는 항상 센서 속도로 나간다.
+        opts.imageHz = declare_parameter("rate.image_hz", opts.imageHz);
+        opts.compressedHz = declare_parameter("rate.compressed_hz", opts.compressedHz);
+        opts.rawHz = declare_parameter("rate.raw_hz", opts.rawHz);
+        opts.imageOnChange = declare_parameter("rate.image_on_change", opts.imageOnChange);
+        opts.imageChangeC = declare_parameter("rate.image_change_c", opts.imageChangeC);
+        opts.imageKeepaliveS = declare_parameter("rate.image_keepalive_s", opts.imageKeepaliveS);
+
+        // 영상/온도 짝짓기: 영상 프레임마다 캡처 시각이 가장 가까운 온도 프레임 (허용 차이 밖이면 unpaired)
+        opts.syncToleranceMs = declare_parameter("sync.tolerance_ms", opts.syncToleranceMs);
+        opts.syncHistory = std::max<int64_t>(2, declare_parameter("sync.history", (int64_t)opts.syncHistory));
+
+        // 캡처 -> 경보 경로 실시간 설정 (공유 SBC 에서 다른 노드의 선점 방지). 적용 결과는 시작 로그에 남긴다.
+        //   rt.analytics_cpus:=[2] rt.analytics_priority:=80 rt.output_cpus:=[3] rt.output_priority:=60 rt.mlockall:=true
+        auto tuning = [this](const std::string &stage, infiray::ThreadTuning &t) {
+            for (int64_t cpu : declare_parameter("rt." + stage + "_cpus", std::vector<int64_t>{})) {
+                t.cpus.push_back((int)cpu);
             }
+            t.fifoPriority = (int)declare_parameter("rt." + stage + "_priority", (int64_t)0);
+        };
+        tuning("analytics", opts.analyticsTuning);
+        tuning("output", opts.outputTuning);
+        tuning("callback", opts.callbackTuning);
+        if (declare_parameter("rt.mlockall", false)) {
+            std::string report;
+            const bool locked = infiray::lockProcessMemory(report);
+            (locked ? std::cout : std::cerr) << "Memory: " << report << "\n";
+            opts.prefaultBuffers = locked;
         }
 
-        if (localIdx < 0 || localW <= 0 || localH <= 0) {
-            rclcpp::spin_some(node);
-            continue;
+        // 분석 -> 출력 -> 화면 단계 사이 큐 길이. 1 이면 항상 가장 최신 프레임만 넘긴다.
+        opts.queueDepth = std::max<int64_t>(1, declare_parameter("pipeline.queue_depth", (int64_t)opts.queueDepth));
+
+        // 카메라 이름 목록. 비어 있으면 기존과 같은 이름 없는 단일 카메라.
+        //   cameras:=[front,rear] -> front.camera_ip, rear.camera_ip ... / /thermal/front/..., /thermal/rear/...
+        std::vector<std::string> names = declare_parameter("cameras", std::vector<std::string>{});
+        if (names.empty()) names.push_back("");
+
+        // raw -> 섭씨 변환 계수는 고정값이므로 latched 로 한 번만 보낸다 (모든 카메라 공통)
+        // intra-process 는 volatile 만 허용하므로 이 토픽만 끈다 (켜 두면 create_publisher 가 던진다)
+        rclcpp::PublisherOptions convOptions;
+        convOptions.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+        conv_pub_ = create_publisher<std_msgs::msg::Float64MultiArray>(
+            "/thermal/raw_conversion", rclcpp::QoS(1).transient_local().reliable(), convOptions);
+        publishRawConversion();
+
+        std::cout << "Starting Thermal App (ROS2 Integrated)\n";
+        std::cout << "Cameras: " << names.size() << "\n";
+        std::cout << "Local Display Mode: " << (opts.showDisplay ? "ON" : "OFF") << "\n";
+        std::cout << "Overlay: " << (opts.publishOverlay ? "ON" : "OFF") << ", Raw: " << (opts.publishRaw ? "ON" : "OFF")
+                  << ", Compressed: " << opts.compressedFormat << "\n";
+
+        cv::setNumThreads(1);
+        infiray::celsiusLut();  // 픽셀 단위 변환 LUT 는 첫 프레임 전에 만들어 둔다
+
+        for (size_t i = 0; i < names.size(); i++) {
+            SessionOptions sessionOpts = opts;
+            // HighGUI 는 스레드 안전하지 않으므로 로컬 창은 첫 카메라만 띄운다
+            if (i > 0 && sessionOpts.showDisplay) {
+                std::cerr << "show_display: only the first camera is shown (" << names[i] << " skipped)\n";
+                sessionOpts.showDisplay = false;
+            }
+            sessions_.push_back(std::make_unique<CameraSession>(*this, names[i], sessionOpts));
         }
-        
-        auto &buf = g_yuvBuf[localIdx];
-        if ((int)buf.size() < localW * localH) continue;
 
-        cv::Mat y(localH, localW, CV_8UC1, (void*)buf.data());
-
-        cv::Mat avgMat;
-        cv::boxFilter(y, avgMat, CV_8U, cv::Size(30, 30));
-        
-        double minVal, maxVal;
-        cv::Point minLoc, maxLoc;
-        cv::minMaxLoc(avgMat, &minVal, &maxVal, &minLoc, &maxLoc);
-
-        int rectX = std::max(0, maxLoc.x - 15);
-        int rectY = std::max(0, maxLoc.y - 15);
-        if (rectX + 30 > localW) rectX = localW - 30;
-        if (rectY + 30 > localH) rectY = localH - 30;
-
-        double celsius = 0.0;
-        bool isTempValid = false;
-        {
-            std::lock_guard<std::mutex> lk(g_tempMtx);
-            if (!g_tempBuf.empty() && (int)g_tempBuf.size() == localW * localH) {
-                long long sumTemp = 0;
-                int count = 0;
-                for (int ty = rectY; ty < rectY + 30; ty++) {
-                    for (int tx = rectX; tx < rectX + 30; tx++) {
-                        sumTemp += g_tempBuf[ty * localW + tx]; 
-                        count++;
-                    }
-                }
-                double avgRawTemp = (double)sumTemp / count;
-                double calcValue = avgRawTemp;
-                double divisor = 10.0;
-
-                if (calcValue > 7300) {
-                    calcValue = calcValue - 3300;
-                    divisor = 15.0;
+        // 단계별 지연 히스토그램을 주기적으로 /diagnostics 로 (선택적으로 CSV 에도) 내보낸다
+        diagPeriodS_ = declare_parameter("diagnostics.period_s", 1.0);
+        const std::string csvPath = declare_parameter("diagnostics.csv_path", std::string(""));
+        if (diagPeriodS_ > 0.0) {
+            diag_pub_ = create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", 10);
+            if (!csvPath.empty()) {
+                diagCsv_ = std::fopen(csvPath.c_str(), "w");
+                if (diagCsv_) {
+                    std::fprintf(diagCsv_, "stamp_ns,camera,stage,count,mean_us,p50_us,p90_us,p99_us,max_us\n");
+                    std::cout << "Latency CSV: " << csvPath << "\n";
                 } else {
-                    calcValue = calcValue + 7000;
-                    divisor = 30.0;
+                    std::cerr << "Cannot open diagnostics CSV: " << csvPath << "\n";
                 }
-                celsius = (calcValue / divisor) - 273.15; 
-                isTempValid = true;
             }
+            diag_timer_ = create_wall_timer(std::chrono::duration<double>(diagPeriodS_),
+                                            [this] { publishDiagnostics(); });
         }
 
-        // [수정점 2] 불필요한 이미지 확대(Resize) 제거하여 데이터 전송량 감소
-        if (displayMode == 1) {
-            cv::cvtColor(y, displayMat, cv::COLOR_GRAY2BGR);
-        } else {
-            cv::applyColorMap(y, displayMat, cv::COLORMAP_INFERNO);
-        }
-
-        // 확대 비율(scale) 제거로 좌표 원복
-        cv::Rect hotZone(rectX, rectY, 30, 30);
-        cv::rectangle(displayMat, hotZone, cv::Scalar(0, 255, 0), 2);
-
-        char textBuf[64];
-        if (isTempValid) {
-            snprintf(textBuf, sizeof(textBuf), "Max: %.1f C", celsius);
-        } else {
-            snprintf(textBuf, sizeof(textBuf), "Wait...");
+        // 단독 실행 파일(thermal_camera_main)만 true 로 올린다. 컨테이너 안에서는 같은 프로세스의
+        // 다른 컴포넌트가 있으므로 카메라가 끝나도 그 세션만 멈추고 rclcpp 는 내리지 않는다.
+        standalone_ = declare_parameter("standalone", false);
+        active_.store((int)sessions_.size());
+        for (auto &session : sessions_) {
+            session->setOnExit([this](CameraSession &, bool userQuit) {
+                // 세션은 스스로 멈춘다. 단독 실행일 때만 ESC 는 곧바로, 재생/합성 소스는 모든 카메라가 끝났을 때 프로세스를 끝낸다.
+                const bool last = active_.fetch_sub(1) == 1;
+                if (standalone_ && (userQuit || last)) rclcpp::shutdown();
+            });
+            if (!session->start()) {
+                throw std::runtime_error("Frame source start failed: " +
+                                         (session->name().empty() ? std::string("camera") : session->name()));
+            }
         }
+    }
 
-        cv::Point textLoc(hotZone.x, hotZone.y - 10);
-        if (textLoc.y < 20) textLoc.y = hotZone.y + hotZone.height + 25;
-        // 폰트 크기 약간 축소 (원본 해상도에 맞춤)
-        cv::putText(displayMat, textBuf, textLoc, cv::FONT_HERSHEY_SIMPLEX, 0.4, cv::Scalar(0, 255, 0), 1);
+    ~ThermalCameraNode() override {
+        std::cout << "\nClosing...\n";
+        diag_timer_.reset();
+        // 세션 소멸자가 처리 스레드와 소스를 멈추고 프레임 통계를 출력한다
+        sessions_.clear();
+        if (diagCsv_) std::fclose(diagCsv_);
+        std::cout << "Done.\n";
+    }
 
-        std_msgs::msg::Header header;
-        header.stamp = node->now();
-        header.frame_id = "thermal_camera_frame";
-        sensor_msgs::msg::Image::SharedPtr img_msg = cv_bridge::CvImage(header, "bgr8", displayMat).toImageMsg();
-        image_pub->publish(*img_msg);
+private:
+    void publishRawConversion() {
+        using C = infiray::RawConversionB;
+        std_msgs::msg::Float64MultiArray msg;
+        std_msgs::msg::MultiArrayDimension dim;
+        dim.label = "split,low_offset,low_divisor,high_offset,high_divisor,kelvin";
+        dim.size = 6;
+        dim.stride = 6;
+        msg.layout.dim.push_back(dim);
+        msg.data = {C::split, C::lowOffset, C::lowDivisor, C::highOffset, C::highDivisor, C::kelvin};
+        conv_pub_->publish(msg);
+    }
 
-        std_msgs::msg::Float32 temp_msg;
-        temp_msg.data = isTempValid ? celsius : 0.0;
-        temp_pub->publish(temp_msg);
+    void publishDiagnostics() {
+        diagnostic_msgs::msg::DiagnosticArray msg;
+        msg.header.stamp = now();
+        const uint64_t stampNs = (uint64_t)msg.header.stamp.sec * 1000000000ull + msg.header.stamp.nanosec;
+        for (auto &session : sessions_) {
+            msg.status.push_back(session->collectDiagnostics(diagPeriodS_, diagCsv_, stampNs));
+        }
+        if (diagCsv_) std::fflush(diagCsv_);
+        diag_pub_->publish(msg);
+    }
 
-        std_msgs::msg::Bool fire_msg;
-        fire_msg.data = (isTempValid && celsius > 80.0);
-        fire_pub->publish(fire_msg);
+    std::vector<std::unique_ptr<CameraSession>> sessions_;
+    std::atomic<int> active_{0};
+    bool standalone_ = false;
+    rclcpp::Publisher<std_msgs::msg::Float64MultiArray>::SharedPtr conv_pub_;
 
-        if (show_display) {
-            cv::imshow("Thermal", displayMat);
-            int key = cv::waitKey(1);
-            if (key == 27) { 
-                g_running.store(false);
-            } else if (key == '1') {
-                displayMode = 1;
-            } else if (key == '2') {
-                displayMode = 2;
-            }
-        }
+    double diagPeriodS_ = 1.0;
+    std::FILE *diagCsv_ = nullptr;
+    rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr diag_pub_;
+    rclcpp::TimerBase::SharedPtr diag_timer_;
+};
 
-        rclcpp::spin_some(node);
-    }
+}  // namespace infiray_ros2
 
-    std::cout << "\nClosing...\n";
-    SetDeviceVideoCallBack(pHandle, nullptr, nullptr);
-    SetTempCallBack(pHandle, nullptr, nullptr);
-    if (show_display) {
-        cv::destroyAllWindows();
-    }
-    sdk_release();
-    rclcpp::shutdown();
-    std::cout << "Done.\n";
-    return 0;
-}
\ No newline at end of file
+RCLCPP_COMPONENTS_REGISTER_NODE(infiray_ros2::ThermalCameraNode)
@@ -0,0 +1,53 @@
+#include "infiray_ros2/latency_stats.hpp"
+
+namespace infiray {
+
+LatencySummary LatencyHistogram::takeInterval() {
+    uint64_t counts[kBuckets];
+    LatencySummary s;
+    for (int i = 0; i < kBuckets; i++) {
+        counts[i] = counts_[i].exchange(0, std::memory_order_relaxed);
+        s.count += counts[i];
+    }
+    const uint64_t sum = sum_.exchange(0, std::memory_order_relaxed);
+    s.maxNs = max_.exchange(0, std::memory_order_relaxed);
+    if (s.count == 0) return s;
+    s.meanNs = (double)sum / (double)s.count;
+
+    // 누적 개수가 분위수를 처음 넘는 칸의 대표값 (max 보다 커지지 않게)
+    const uint64_t rank50 = (s.count * 50 + 99) / 100;
+    const uint64_t rank90 = (s.count * 90 + 99) / 100;
+    const uint64_t rank99 = (s.count * 99 + 99) / 100;
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; i++) {
+        if (counts[i] == 0) continue;
+        const uint64_t before = seen;
+        seen += counts[i];
+        const uint64_t v = bucketValue(i) < s.maxNs ? bucketValue(i) : s.maxNs;
+        if (before < rank50 && seen >= rank50) s.p50Ns = v;
+        if (before < rank90 && seen >= rank90) s.p90Ns = v;
+        if (before < rank99 && seen >= rank99) s.p99Ns = v;
+    }
+    return s;
+}
+
+const char *stageName(Stage stage) {
+    switch (stage) {
+    case Stage::kCallbackCopy: return "callback_copy";
+    case Stage::kDecode: return "decode";
+    case Stage::kHotspot: return "hotspot";
+    case Stage::kFire: return "fire";
+    case Stage::kBlobs: return "blobs";
+    case Stage::kStats: return "stats";
+    case Stage::kRender: return "render";
+    case Stage::kEncode: return "encode";
+    case Stage::kSerialize: return "serialize";
+    case Stage::kPublish: return "publish";
+    case Stage::kCaptureToAlarm: return "capture_to_alarm";
+    case Stage::kCaptureToImage: return "capture_to_image";
+    case Stage::kPairOffset: return "pair_offset";
+    default: return "unknown";
+    }
+}
+
+}  // namespace infiray
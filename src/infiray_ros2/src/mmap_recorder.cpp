@@ -0,0 +1,292 @@
+#include "infiray_ros2/mmap_recorder.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+namespace infiray {
+
+namespace fs = std::filesystem;
+
+static std::string segmentStem(const std::string &base) {
+    const std::string ext = ".irrec";
+    if (base.size() > ext.size() && base.compare(base.size() - ext.size(), ext.size(), ext) == 0) {
+        return base.substr(0, base.size() - ext.size());
+    }
+    return base;
+}
+
+std::string MmapRecorder::segmentPath(const std::string &base, int index) {
+    char num[16];
+    std::snprintf(num, sizeof(num), "_%04d", index);
+    return segmentStem(base) + num + ".irrec";
+}
+
+bool MmapRecorder::open(const MmapRecorderConfig &cfg) {
+    close();
+    cfg_ = cfg;
+    if (cfg_.path.empty() || cfg_.segmentBytes <= sizeof(FileHeader) + sizeof(RecordHeader)) return false;
+    if (cfg_.recordBytes <= sizeof(RecordHeader)) return false;
+
+    const long page = sysconf(_SC_PAGESIZE);
+    pageSize_ = page > 0 ? (size_t)page : 4096;
+    nextSegment_ = 0;
+    failed_ = false;
+    closing_ = false;
+    recorded_.store(0);
+    dropped_.store(0);
+    bytesWritten_.store(0);
+    segments_.store(0);
+    // 경로 오류는 첫 프레임이 아니라 여기서 드러나도록 첫 세그먼트를 바로 연다
+    if (!openSegment()) return false;
+
+    // 큐 블록과 대기 링을 여기서 모두 잡는다 (append 는 할당하지 않는다).
+    // 0 으로 채워 페이지까지 미리 받아 두므로 첫 프레임들에서 page fault 가 몰리지 않는다.
+    const size_t count = std::max<size_t>(1, cfg_.queueBytes / cfg_.recordBytes);
+    blocks_.resize(count);
+    free_.clear();
+    free_.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        blocks_[i].data.assign(cfg_.recordBytes, 0);
+        free_.push_back((uint32_t)(count - 1 - i));
+    }
+    pending_.assign(count, 0);
+    pendingHead_ = pendingCount_ = 0;
+
+    open_.store(true, std::memory_order_release);
+    thread_ = std::thread(&MmapRecorder::run, this);
+    return true;
+}
+
+void MmapRecorder::close() {
+    if (!thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        closing_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    open_.store(false, std::memory_order_release);
+
+    std::lock_guard<std::mutex> lk(mtx_);
+    blocks_.clear();
+    blocks_.shrink_to_fit();
+    free_.clear();
+    pending_.clear();
+    pendingHead_ = pendingCount_ = 0;
+}
+
+bool MmapRecorder::append(const RecordHeader &hdr, const void *video, const void *temp) {
+    const size_t need = sizeof(RecordHeader) + hdr.videoBytes + hdr.tempBytes;
+    if (need > cfg_.recordBytes || need > cfg_.segmentBytes - sizeof(FileHeader)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 빈 블록을 하나 받는다. 없으면 기다리지 않고 이 프레임을 버린다.
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (closing_ || !open_.load(std::memory_order_relaxed)) return false;
+        if (free_.empty()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        id = free_.back();
+        free_.pop_back();
+    }
+
+    Block &block = blocks_[id];
+    RecordHeader rh = hdr;
+    rh.magic = kRecordMagic;
+    uint8_t *dst = block.data.data();
+    std::memcpy(dst, &rh, sizeof(rh));
+    dst += sizeof(rh);
+    if (rh.videoBytes > 0) std::memcpy(dst, video, rh.videoBytes);
+    dst += rh.videoBytes;
+    if (rh.tempBytes > 0) std::memcpy(dst, temp, rh.tempBytes);
+    block.size = need;
+
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        // 블록 수만큼의 링이라 넘치지 않는다
+        pending_[(pendingHead_ + pendingCount_) % pending_.size()] = id;
+        pendingCount_++;
+    }
+    cv_.notify_one();
+    return true;
+}
+
+void MmapRecorder::run() {
+    for (;;) {
+        uint32_t id;
+        {
+            std::unique_lock<std::mutex> lk(mtx_);
+            // 닫는 중이어도 append 가 채우고 있는 블록이 돌아올 때까지는 끝내지 않는다 (close 가 블록을 푼다)
+            cv_.wait(lk, [this] { return pendingCount_ > 0 || (closing_ && free_.size() == blocks_.size()); });
+            if (pendingCount_ == 0) break;  // 닫는 중이고 남은 프레임도 없음
+            id = pending_[pendingHead_];
+            pendingHead_ = (pendingHead_ + 1) % pending_.size();
+            pendingCount_--;
+        }
+        writeBlock(blocks_[id].data.data(), blocks_[id].size);
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            free_.push_back(id);
+        }
+    }
+    closeSegment();
+}
+
+void MmapRecorder::writeBlock(const uint8_t *data, size_t n) {
+    if (map_ != nullptr && offset_ + n > cfg_.segmentBytes) closeSegment();
+    if (map_ == nullptr && (failed_ || !openSegment())) {
+        failed_ = true;
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::memcpy(map_ + offset_, data, n);
+    const auto *rh = reinterpret_cast<const RecordHeader *>(data);
+    index_.push_back({rh->captureNs, offset_, (uint32_t)n, rh->videoFormat, rh->tempFormat});
+    offset_ += n;
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+    bytesWritten_.fetch_add(n, std::memory_order_relaxed);
+
+    if (offset_ - flushedTo_ >= cfg_.writebackBytes) writeback();
+}
+
+// 새로 채운 구간은 내보내기만 시작하고, 그 앞 구간(이미 내보내기 시작한)은 완료를 기다려
+// 매핑과 페이지 캐시에서 내린다. 더러운 페이지가 writebackBytes 의 두 배를 넘지 않는다.
+void MmapRecorder::writeback() {
+    const uint64_t end = offset_ / pageSize_ * pageSize_;
+    if (end <= flushedTo_) return;
+
+#ifdef __linux__
+    sync_file_range(fd_, (off64_t)flushedTo_, (off64_t)(end - flushedTo_), SYNC_FILE_RANGE_WRITE);
+#else
+    msync(map_ + flushedTo_, end - flushedTo_, MS_ASYNC);
+#endif
+    if (flushedTo_ > droppedTo_) {
+        const size_t len = flushedTo_ - droppedTo_;
+        msync(map_ + droppedTo_, len, MS_SYNC);
+        madvise(map_ + droppedTo_, len, MADV_DONTNEED);
+        posix_fadvise(fd_, (off_t)droppedTo_, (off_t)len, POSIX_FADV_DONTNEED);
+        droppedTo_ = flushedTo_;
+    }
+    flushedTo_ = end;
+}
+
+bool MmapRecorder::openSegment() {
+    const int index = nextSegment_;
+    segPath_ = segmentPath(cfg_.path, index);
+    fd_ = ::open(segPath_.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "Recorder: cannot open " << segPath_ << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    // 디스크 공간을 미리 잡아 두어야 기록 중에 공간 부족이 SIGBUS 로 나타나지 않는다
+    const int err = posix_fallocate(fd_, 0, (off_t)cfg_.segmentBytes);
+    if (err != 0) {
+        std::cerr << "Recorder: cannot preallocate " << segPath_ << ": " << std::strerror(err) << "\n";
+        ::close(fd_);
+        fd_ = -1;
+        ::unlink(segPath_.c_str());
+        return false;
+    }
+    void *p = mmap(nullptr, cfg_.segmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (p == MAP_FAILED) {
+        std::cerr << "Recorder: mmap failed for " << segPath_ << ": " << std::strerror(errno) << "\n";
+        ::close(fd_);
+        fd_ = -1;
+        ::unlink(segPath_.c_str());
+        return false;
+    }
+    map_ = static_cast<uint8_t *>(p);
+    // rt.mlockall 이어도 세그먼트는 잠그지 않는다 (잠긴 페이지는 writeback 뒤 내릴 수 없다)
+    munlock(map_, cfg_.segmentBytes);
+    // 기록 패턴이 순차이므로 커널에 알려 둔다
+    madvise(map_, cfg_.segmentBytes, MADV_SEQUENTIAL);
+
+    FileHeader fh;
+    std::memset(&fh, 0, sizeof(fh));
+    std::memcpy(fh.magic, kRecordFileMagic, sizeof(fh.magic));
+    fh.version = kRecordVersion;
+    std::memcpy(map_, &fh, sizeof(fh));
+    offset_ = sizeof(fh);
+    flushedTo_ = droppedTo_ = 0;
+    index_.clear();
+
+    nextSegment_++;
+    segments_.fetch_add(1, std::memory_order_relaxed);
+    if (cfg_.maxSegments > 0 && index >= cfg_.maxSegments) {
+        const std::string old = segmentPath(cfg_.path, index - cfg_.maxSegments);
+        ::unlink(old.c_str());
+        ::unlink((old + ".idx").c_str());
+    }
+    return true;
+}
+
+void MmapRecorder::closeSegment() {
+    if (map_ == nullptr) return;
+
+    msync(map_, offset_, MS_SYNC);
+    munmap(map_, cfg_.segmentBytes);
+    map_ = nullptr;
+    // 선할당한 나머지를 잘라 재생/복사 시 빈 영역이 남지 않게 한다
+    if (ftruncate(fd_, (off_t)offset_) != 0) {
+        std::cerr << "Recorder: cannot truncate " << segPath_ << ": " << std::strerror(errno) << "\n";
+    }
+    posix_fadvise(fd_, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(fd_);
+    fd_ = -1;
+
+    const std::string idxPath = segPath_ + ".idx";
+    if (std::FILE *fp = std::fopen(idxPath.c_str(), "wb")) {
+        IndexFileHeader ih;
+        std::memcpy(ih.magic, kIndexFileMagic, sizeof(ih.magic));
+        ih.count = index_.size();
+        bool ok = std::fwrite(&ih, sizeof(ih), 1, fp) == 1;
+        if (!index_.empty()) ok = ok && std::fwrite(index_.data(), sizeof(RecordIndexEntry), index_.size(), fp) == index_.size();
+        if (std::fclose(fp) != 0 || !ok) std::cerr << "Recorder: cannot write " << idxPath << "\n";
+    } else {
+        std::cerr << "Recorder: cannot open " << idxPath << "\n";
+    }
+}
+
+std::vector<std::string> listRecordSegments(const std::string &base) {
+    std::error_code ec;
+    if (fs::is_regular_file(base, ec)) return {base};
+
+    // <stem>_<번호>.irrec 만 모은다 (max_segments 로 앞 번호가 지워졌을 수 있으므로 디렉터리를 훑는다).
+    // 번호는 4 자리로 채우지만 9999 를 넘으면 더 길어지므로 자릿수와 상관없이 받아 숫자 순으로 정렬한다.
+    const fs::path stem(segmentStem(base));
+    const fs::path dir = stem.has_parent_path() ? stem.parent_path() : fs::path(".");
+    const std::string prefix = stem.filename().string() + "_";
+    const std::string ext = ".irrec";
+    std::vector<std::pair<uint64_t, std::string>> found;
+    for (const auto &entry : fs::directory_iterator(dir, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() <= prefix.size() + ext.size() || name.compare(0, prefix.size(), prefix) != 0) continue;
+        if (name.compare(name.size() - ext.size(), ext.size(), ext) != 0) continue;
+        const auto first = name.begin() + prefix.size();
+        const auto last = name.end() - ext.size();
+        if (last - first > 18 || !std::all_of(first, last, [](char c) { return c >= '0' && c <= '9'; })) continue;
+        found.emplace_back(std::stoull(std::string(first, last)), entry.path().string());
+    }
+    std::sort(found.begin(), found.end());
+    std::vector<std::string> out;
+    out.reserve(found.size());
+    for (auto &f : found) out.push_back(std::move(f.second));
+    return out;
+}
+
+}  // namespace infiray
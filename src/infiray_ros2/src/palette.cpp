@@ -0,0 +1,89 @@
+#include "infiray_ros2/palette.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace infiray {
+
+Palette8 grayPalette() {
+    Palette8 p;
+    for (int i = 0; i < 256; i++) p.bgr[i] = packBgr((uint8_t)i, (uint8_t)i, (uint8_t)i);
+    return p;
+}
+
+Palette8 paletteFromBgr(const uint8_t *bgr) {
+    Palette8 p;
+    for (int i = 0; i < 256; i++) p.bgr[i] = packBgr(bgr[3 * i], bgr[3 * i + 1], bgr[3 * i + 2]);
+    return p;
+}
+
+void buildRawPalette(const Palette8 &palette, const float *celsius, int levels, float minC, float maxC,
+                     PaletteRaw &out) {
+    out.bgr.resize((size_t)levels);
+    out.minC = minC;
+    out.maxC = maxC;
+    const float span = maxC > minC ? maxC - minC : 1.0f;
+    for (int r = 0; r < levels; r++) {
+        const float t = (celsius[r] - minC) / span * 255.0f + 0.5f;
+        const int idx = t <= 0.0f ? 0 : t >= 255.0f ? 255 : (int)t;
+        out.bgr[r] = palette.bgr[idx];
+    }
+}
+
+// 4 픽셀(12 바이트)을 uint32 3개로 쓴다
+static inline void store4(uint8_t *d, uint32_t a, uint32_t b, uint32_t c, uint32_t e) {
+    const uint32_t w0 = a | b << 24;
+    const uint32_t w1 = b >> 8 | c << 16;
+    const uint32_t w2 = c >> 16 | e << 8;
+    std::memcpy(d, &w0, 4);
+    std::memcpy(d + 4, &w1, 4);
+    std::memcpy(d + 8, &w2, 4);
+}
+
+static inline void store1(uint8_t *d, uint32_t a) {
+    d[0] = (uint8_t)a;
+    d[1] = (uint8_t)(a >> 8);
+    d[2] = (uint8_t)(a >> 16);
+}
+
+// Lookup(v) 가 팔레트 색. 마스크 유무로 루프를 나눠 마스크 없는 흔한 경우에 select 가 없게 한다.
+template <typename T, typename Lookup>
+static void renderRows(const T *src, size_t srcStride, int width, int height, Lookup lookup, const uint8_t *mask,
+                       size_t maskStride, uint32_t maskBgr, uint8_t *dst, size_t dstStride) {
+    for (int y = 0; y < height; y++) {
+        const T *s = reinterpret_cast<const T *>(reinterpret_cast<const uint8_t *>(src) + (size_t)y * srcStride);
+        uint8_t *d = dst + (size_t)y * dstStride;
+        int x = 0;
+        if (mask == nullptr) {
+            for (; x + 4 <= width; x += 4) {
+                store4(d + 3 * x, lookup(s[x]), lookup(s[x + 1]), lookup(s[x + 2]), lookup(s[x + 3]));
+            }
+            for (; x < width; x++) store1(d + 3 * x, lookup(s[x]));
+        } else {
+            const uint8_t *m = mask + (size_t)y * maskStride;
+            for (; x + 4 <= width; x += 4) {
+                store4(d + 3 * x, m[x] ? maskBgr : lookup(s[x]), m[x + 1] ? maskBgr : lookup(s[x + 1]),
+                       m[x + 2] ? maskBgr : lookup(s[x + 2]), m[x + 3] ? maskBgr : lookup(s[x + 3]));
+            }
+            for (; x < width; x++) store1(d + 3 * x, m[x] ? maskBgr : lookup(s[x]));
+        }
+    }
+}
+
+void renderPalette8(const uint8_t *src, size_t srcStride, int width, int height, const Palette8 &palette,
+                    const uint8_t *mask, size_t maskStride, uint32_t maskBgr, uint8_t *dst, size_t dstStride) {
+    const uint32_t *lut = palette.bgr;
+    renderRows(src, srcStride, width, height, [lut](uint8_t v) { return lut[v]; }, mask, maskStride, maskBgr, dst,
+               dstStride);
+}
+
+void renderPaletteRaw(const uint16_t *src, size_t srcStride, int width, int height, const PaletteRaw &palette,
+                      const uint8_t *mask, size_t maskStride, uint32_t maskBgr, uint8_t *dst, size_t dstStride) {
+    if (palette.bgr.empty()) return;
+    const uint32_t *lut = palette.bgr.data();
+    const uint16_t last = (uint16_t)(palette.bgr.size() - 1);
+    renderRows(src, srcStride, width, height, [lut, last](uint16_t v) { return lut[std::min(v, last)]; }, mask,
+               maskStride, maskBgr, dst, dstStride);
+}
+
+}  // namespace infiray
@@ -0,0 +1,84 @@
+#include "infiray_ros2/rt_tuning.hpp"
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace infiray {
+
+static std::string errorText(int err) {
+    std::string s = std::strerror(err);
+    if (err == EPERM) s += ", needs CAP_SYS_NICE or an rtprio limit";
+    return s;
+}
+
+bool applyThreadTuning(pthread_t thread, const ThreadTuning &tuning, std::string &report) {
+    bool ok = true;
+    report.clear();
+
+    if (!tuning.cpus.empty()) {
+        report = "cpus ";
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        const long ncpu = sysconf(_SC_NPROCESSORS_CONF);
+        bool valid = true;
+        for (size_t i = 0; i < tuning.cpus.size(); i++) {
+            const int cpu = tuning.cpus[i];
+            report += (i > 0 ? "," : "") + std::to_string(cpu);
+            if (cpu < 0 || cpu >= ncpu || cpu >= CPU_SETSIZE) {
+                valid = false;
+                continue;
+            }
+            CPU_SET(cpu, &set);
+        }
+        if (!valid) {
+            report += " failed (no such cpu)";
+            ok = false;
+        } else {
+            const int err = pthread_setaffinity_np(thread, sizeof(set), &set);
+            report += err == 0 ? " ok" : " failed (" + errorText(err) + ")";
+            ok = ok && err == 0;
+        }
+    }
+
+    if (tuning.fifoPriority > 0) {
+        if (!report.empty()) report += ", ";
+        const int lo = sched_get_priority_min(SCHED_FIFO);
+        const int hi = sched_get_priority_max(SCHED_FIFO);
+        sched_param param{};
+        param.sched_priority = tuning.fifoPriority < lo ? lo : (tuning.fifoPriority > hi ? hi : tuning.fifoPriority);
+        report += "SCHED_FIFO " + std::to_string(param.sched_priority);
+        const int err = pthread_setschedparam(thread, SCHED_FIFO, &param);
+        report += err == 0 ? " ok" : " failed (" + errorText(err) + ")";
+        ok = ok && err == 0;
+    }
+
+    if (report.empty()) report = "default";
+    return ok;
+}
+
+bool lockProcessMemory(std::string &report) {
+    int flags = MCL_CURRENT | MCL_FUTURE;
+#ifdef MCL_ONFAULT
+    // 예약만 한 큰 매핑(녹화 세그먼트 등)을 한꺼번에 채우지 않고 실제로 쓰는 페이지만 잠근다
+    flags |= MCL_ONFAULT;
+#endif
+    if (mlockall(flags) == 0) {
+        report = "mlockall ok";
+        return true;
+    }
+    const int err = errno;
+    report = std::string("mlockall failed (") + std::strerror(err);
+    struct rlimit lim;
+    if (getrlimit(RLIMIT_MEMLOCK, &lim) == 0 && lim.rlim_cur != RLIM_INFINITY) {
+        report += ", memlock limit " + std::to_string((unsigned long long)lim.rlim_cur >> 10) + " KB";
+    }
+    report += ")";
+    return false;
+}
+
+}  // namespace infiray
@@ -0,0 +1,150 @@
+#include "infiray_ros2/frame_source.hpp"
+
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <unistd.h>
+
+#ifdef INFIRAY_WITH_SDK
+
+// --- [윈도우 호환용 매크로 정의] ---
+#ifndef _WIN32
+    #define __stdcall
+    #define CALLINGCONVEN
+    #define CNET_APIIMPORT
+    #define CALLBACK
+    #define WINAPI
+    typedef unsigned long DWORD;
+    typedef unsigned short WORD;
+    typedef unsigned char BYTE;
+    typedef long LPARAM;
+    typedef unsigned long WPARAM;
+    typedef int BOOL;
+    typedef unsigned int UINT;
+    typedef void* HWND;
+    typedef void* HANDLE;
+    typedef void* HDC;
+    typedef unsigned int COLORREF;
+    typedef long LONG;
+    typedef struct _RECT { LONG left; LONG top; LONG right; LONG bottom; } RECT;
+    #ifndef TRUE
+        #define TRUE 1
+    #endif
+    #ifndef FALSE
+        #define FALSE 0
+    #endif
+#endif
+
+#include "LinuxDef.h"
+#include "InfraredTempSDK.h"
+
+namespace infiray {
+
+// ---- 프로세스 전체에서 한 번만 하는 SDK 초기화 ----
+// sdk_initialize/sdk_release 는 전역 상태라 카메라가 여러 대여도 한 번씩만 부른다.
+// 장치 종류(sdk_set_type)도 전역이므로 첫 카메라의 값을 따른다.
+static std::mutex g_sdkMtx;
+static int g_sdkRefs = 0;
+static int g_sdkDeviceType = -1;
+
+static bool acquireSdk(const SdkSourceConfig &cfg, char *username, char *password) {
+    std::lock_guard<std::mutex> lk(g_sdkMtx);
+    if (g_sdkRefs > 0) {
+        if (cfg.deviceType != g_sdkDeviceType) {
+            std::cerr << "SDK already initialized with device type " << g_sdkDeviceType
+                      << ", ignoring " << cfg.deviceType << " for " << cfg.ip << "\n";
+        }
+        g_sdkRefs++;
+        return true;
+    }
+
+    sdk_set_type(cfg.deviceType, username, password);
+    if (sdk_initialize() < 0) {
+        std::cerr << "SDK Init Failed\n";
+        return false;
+    }
+    sleep(1);
+    g_sdkDeviceType = cfg.deviceType;
+    g_sdkRefs = 1;
+    return true;
+}
+
+static void releaseSdk() {
+    std::lock_guard<std::mutex> lk(g_sdkMtx);
+    if (g_sdkRefs > 0 && --g_sdkRefs == 0) {
+        sdk_release();
+        g_sdkDeviceType = -1;
+    }
+}
+
+// ---- 실제 카메라 소스: 기존 main() 의 SDK 초기화/로그인 절차를 그대로 옮김 ----
+class SdkFrameSource : public FrameSource {
+public:
+    explicit SdkFrameSource(const SdkSourceConfig &cfg) : cfg_(cfg) {}
+    ~SdkFrameSource() override { stop(); }
+
+    bool start() override {
+        if (started_) return true;
+
+        char username[32];
+        char password[32];
+        snprintf(username, sizeof(username), "%s", cfg_.username.c_str());
+        snprintf(password, sizeof(password), "%s", cfg_.password.c_str());
+
+        if (!acquireSdk(cfg_, username, password)) return false;
+        pHandle_ = sdk_create();
+
+        ChannelInfo devInfo;
+        memset(&devInfo, 0, sizeof(ChannelInfo));
+        strcpy(devInfo.szUserName, username);
+        strcpy(devInfo.szPWD, password);
+        snprintf(devInfo.szIP, sizeof(devInfo.szIP), "%s", cfg_.ip.c_str());
+        devInfo.wPortNum = cfg_.port;
+
+        if (sdk_loginDevice(pHandle_, devInfo) != 0) {
+            std::cerr << "Login Failed: " << cfg_.ip << "\n";
+            releaseSdk();
+            return false;
+        }
+
+        SetDeviceVideoCallBack(pHandle_, videoCb_, context_);
+        SetTempCallBack(pHandle_, tempCb_, context_);
+        sdk_start_url(pHandle_, devInfo.szIP);
+        started_ = true;
+        return true;
+    }
+
+    void stop() override {
+        if (!started_) return;
+        SetDeviceVideoCallBack(pHandle_, nullptr, nullptr);
+        SetTempCallBack(pHandle_, nullptr, nullptr);
+        releaseSdk();
+        started_ = false;
+    }
+
+    const char *name() const override { return "sdk"; }
+
+private:
+    SdkSourceConfig cfg_;
+    IRNETHANDLE pHandle_{};
+    bool started_ = false;
+};
+
+std::unique_ptr<FrameSource> makeSdkFrameSource(const SdkSourceConfig &cfg) {
+    return std::make_unique<SdkFrameSource>(cfg);
+}
+
+}  // namespace infiray
+
+#else
+
+namespace infiray {
+
+std::unique_ptr<FrameSource> makeSdkFrameSource(const SdkSourceConfig &) {
+    std::cerr << "Built without InfiRay SDK (INFIRAY_WITH_SDK=OFF)\n";
+    return nullptr;
+}
+
+}  // namespace infiray
+
+#endif
@@ -0,0 +1,278 @@
+#include "infiray_ros2/shm_ring.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace infiray {
+
+static constexpr size_t kSlotAlign = 64;
+
+static void wakeReaders(ShmRingHeader *h) {
+    h->futexWord.fetch_add(1, std::memory_order_release);
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&h->futexWord), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+static const uint8_t *slotBase(const ShmRingHeader *h, uint64_t seq) {
+    return reinterpret_cast<const uint8_t *>(h) + h->dataOffset + ((seq - 1) % h->slotCount) * h->slotStride;
+}
+
+// ================= 쓰는 쪽 =================
+
+void ShmFrameWriter::configure(const std::string &name, uint32_t slotCount) {
+    close();
+    name_ = name;
+    slotCount_ = std::max<uint32_t>(2, slotCount);
+}
+
+void ShmFrameWriter::close() {
+    if (header_ == nullptr) return;
+    header_->stale.store(1, std::memory_order_release);
+    wakeReaders(header_);
+    munmap(header_, mapBytes_);
+    header_ = nullptr;
+    shm_unlink(name_.c_str());
+}
+
+bool ShmFrameWriter::create(uint64_t slotBytes) {
+    if (header_ != nullptr) {
+        header_->stale.store(1, std::memory_order_release);
+        wakeReaders(header_);
+        munmap(header_, mapBytes_);
+        header_ = nullptr;
+    }
+
+    // 이전 실행이 남긴 같은 이름의 객체에 붙어 있는 리더도 다시 열도록 stale 로 표시한다
+    const int old = shm_open(name_.c_str(), O_RDWR, 0);
+    if (old >= 0) {
+        struct stat st;
+        if (fstat(old, &st) == 0 && (size_t)st.st_size >= sizeof(ShmRingHeader)) {
+            void *p = mmap(nullptr, sizeof(ShmRingHeader), PROT_READ | PROT_WRITE, MAP_SHARED, old, 0);
+            if (p != MAP_FAILED) {
+                auto *h = static_cast<ShmRingHeader *>(p);
+                if (std::memcmp(h->magic, kShmMagic, sizeof(kShmMagic)) == 0) {
+                    generation_ = std::max(generation_, h->generation);
+                    h->stale.store(1, std::memory_order_release);
+                    wakeReaders(h);
+                }
+                munmap(p, sizeof(ShmRingHeader));
+            }
+        }
+        ::close(old);
+        shm_unlink(name_.c_str());
+    }
+
+    const int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "Shm: cannot create " << name_ << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+    const uint64_t stride = (sizeof(ShmSlotHeader) + slotBytes + kSlotAlign - 1) / kSlotAlign * kSlotAlign;
+    const size_t total = sizeof(ShmRingHeader) + (size_t)slotCount_ * stride;
+    if (ftruncate(fd, (off_t)total) != 0) {
+        std::cerr << "Shm: cannot size " << name_ << ": " << std::strerror(errno) << "\n";
+        ::close(fd);
+        shm_unlink(name_.c_str());
+        return false;
+    }
+    void *p = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "Shm: mmap failed for " << name_ << ": " << std::strerror(errno) << "\n";
+        shm_unlink(name_.c_str());
+        return false;
+    }
+
+    // ftruncate 로 0 이 채워져 있으므로 필드만 채우고, 리더가 보는 magic 은 마지막에 쓴다
+    header_ = static_cast<ShmRingHeader *>(p);
+    mapBytes_ = total;
+    header_->version = kShmVersion;
+    header_->slotCount = slotCount_;
+    header_->slotBytes = slotBytes;
+    header_->slotStride = stride;
+    header_->dataOffset = sizeof(ShmRingHeader);
+    header_->writerPid = (uint32_t)getpid();
+    header_->generation = ++generation_;
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header_->magic, kShmMagic, sizeof(kShmMagic));
+    seq_ = 0;
+    return true;
+}
+
+bool ShmFrameWriter::write(ShmFormat format, uint32_t width, uint32_t height, uint32_t rowBytes, const void *data,
+                           size_t srcStride, uint64_t captureNs) {
+    if (name_.empty() || data == nullptr) return false;
+    const uint64_t bytes = (uint64_t)rowBytes * height;
+    if (header_ == nullptr || bytes > header_->slotBytes) {
+        if (!create(bytes)) return false;
+    }
+
+    const uint64_t seq = seq_ + 1;
+    auto *slot = reinterpret_cast<ShmSlotHeader *>(const_cast<uint8_t *>(slotBase(header_, seq)));
+    uint8_t *payload = reinterpret_cast<uint8_t *>(slot) + sizeof(ShmSlotHeader);
+
+    const uint64_t lock = slot->lock.load(std::memory_order_relaxed);
+    slot->lock.store(lock + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->seq = seq;
+    slot->captureNs = captureNs;
+    slot->width = width;
+    slot->height = height;
+    slot->format = format;
+    slot->rowBytes = rowBytes;
+    slot->bytes = bytes;
+    const auto *src = static_cast<const uint8_t *>(data);
+    if (srcStride == rowBytes) {
+        std::memcpy(payload, src, bytes);
+    } else {
+        for (uint32_t y = 0; y < height; y++) std::memcpy(payload + (size_t)y * rowBytes, src + y * srcStride, rowBytes);
+    }
+
+    slot->lock.store(lock + 2, std::memory_order_release);
+    header_->latest.store(seq, std::memory_order_release);
+    wakeReaders(header_);
+    seq_ = seq;
+    return true;
+}
+
+// ================= 읽는 쪽 =================
+
+bool ShmFrameReader::open(const std::string &name) {
+    close();
+    name_ = name;
+    const int fd = shm_open(name_.c_str(), O_RDONLY, 0);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(ShmRingHeader)) {
+        ::close(fd);
+        return false;  // 쓰는 쪽이 아직 만드는 중
+    }
+    void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) return false;
+
+    auto *h = static_cast<ShmRingHeader *>(p);
+    const bool ok = std::memcmp(h->magic, kShmMagic, sizeof(kShmMagic)) == 0 && h->version == kShmVersion &&
+                    h->slotCount > 0 && h->dataOffset + h->slotCount * h->slotStride <= (uint64_t)st.st_size;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!ok) {
+        munmap(p, (size_t)st.st_size);
+        return false;
+    }
+    header_ = h;
+    mapBytes_ = (size_t)st.st_size;
+    lastSeq_ = 0;
+    return true;
+}
+
+void ShmFrameReader::close() {
+    if (header_ == nullptr) return;
+    munmap(header_, mapBytes_);
+    header_ = nullptr;
+}
+
+bool ShmFrameReader::ensureOpen() {
+    if (header_ != nullptr && header_->stale.load(std::memory_order_acquire) != 0) close();
+    if (header_ == nullptr && !name_.empty()) open(name_);
+    return header_ != nullptr;
+}
+
+const ShmSlotHeader *ShmFrameReader::slotAt(uint64_t seq) const {
+    return reinterpret_cast<const ShmSlotHeader *>(slotBase(header_, seq));
+}
+
+bool ShmFrameReader::latest(ShmFrameView &view) {
+    if (!ensureOpen()) return false;
+    for (int attempt = 0; attempt < 4; attempt++) {
+        const uint64_t seq = header_->latest.load(std::memory_order_acquire);
+        if (seq == 0 || seq == lastSeq_) return false;
+
+        const ShmSlotHeader *s = slotAt(seq);
+        const uint64_t lock = s->lock.load(std::memory_order_acquire);
+        if ((lock & 1) == 0 && s->seq == seq) {
+            view.seq = seq;
+            view.captureNs = s->captureNs;
+            view.width = s->width;
+            view.height = s->height;
+            view.format = s->format;
+            view.rowBytes = s->rowBytes;
+            view.bytes = std::min<uint64_t>(s->bytes, header_->slotBytes);
+            view.data = reinterpret_cast<const uint8_t *>(s) + sizeof(ShmSlotHeader);
+            view.slot = s;
+            view.lock = lock;
+            if (valid(view)) {
+                lastSeq_ = seq;
+                return true;
+            }
+        }
+        torn_++;  // 읽는 사이 쓰는 쪽이 한 바퀴 돌았다
+    }
+    return false;
+}
+
+bool ShmFrameReader::valid(const ShmFrameView &view) const {
+    if (view.slot == nullptr) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return view.slot->lock.load(std::memory_order_relaxed) == view.lock;
+}
+
+bool ShmFrameReader::copyLatest(std::vector<uint8_t> &out, ShmFrameView &meta) {
+    for (int attempt = 0; attempt < 4; attempt++) {
+        ShmFrameView v;
+        if (!latest(v)) return false;
+        out.resize(v.bytes);
+        std::memcpy(out.data(), v.data, v.bytes);
+        if (valid(v)) {
+            meta = v;
+            meta.data = out.data();
+            return true;
+        }
+        torn_++;
+    }
+    return false;
+}
+
+bool ShmFrameReader::waitNew(std::chrono::milliseconds timeout) {
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + timeout;
+    for (;;) {
+        const auto remaining = deadline - clock::now();
+        if (!ensureOpen()) {
+            // 쓰는 쪽이 아직 없다
+            if (remaining <= clock::duration::zero()) return false;
+            std::this_thread::sleep_for(std::min<clock::duration>(remaining, std::chrono::milliseconds(50)));
+            continue;
+        }
+        const uint32_t word = header_->futexWord.load(std::memory_order_acquire);
+        const uint64_t seq = header_->latest.load(std::memory_order_acquire);
+        if (seq != 0 && seq != lastSeq_) return true;
+        if (header_->stale.load(std::memory_order_acquire) != 0) continue;
+        if (remaining <= clock::duration::zero()) return false;
+#ifdef __linux__
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        struct timespec ts;
+        ts.tv_sec = (time_t)(ns / 1000000000);
+        ts.tv_nsec = (long)(ns % 1000000000);
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&header_->futexWord), FUTEX_WAIT, word, &ts, nullptr, 0);
+#else
+        (void)word;
+        std::this_thread::sleep_for(std::min<clock::duration>(remaining, std::chrono::milliseconds(1)));
+#endif
+    }
+}
+
+}  // namespace infiray
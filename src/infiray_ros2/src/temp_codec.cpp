@@ -0,0 +1,79 @@
+#include "infiray_ros2/temp_codec.hpp"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace infiray {
+
+// 하위 바이트 평면은 픽셀 쌍마다 순서가 뒤바뀌어 있으므로 16비트 단위로 바이트를 스왑한 뒤
+// (lo, hi) 로 인터리브하면 리틀엔디언 uint16 출력이 그대로 나온다.
+
+void decodeTempB(const uint8_t *buf, size_t numPixels, uint16_t *out) {
+    const uint8_t *hi = buf;
+    const uint8_t *lo = buf + numPixels;
+    const size_t evenPixels = numPixels & ~(size_t)1;
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i swap16 = _mm256_setr_epi8(
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for (; i + 32 <= evenPixels; i += 32) {
+        __m256i h = _mm256_loadu_si256((const __m256i *)(hi + i));
+        __m256i l = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)(lo + i)), swap16);
+        // unpack 은 128비트 lane 단위이므로 lane 을 다시 맞춘다
+        __m256i a = _mm256_unpacklo_epi8(l, h);
+        __m256i b = _mm256_unpackhi_epi8(l, h);
+        _mm256_storeu_si256((__m256i *)(out + i),      _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + i + 16), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+#endif
+
+#if defined(__SSE2__)
+    for (; i + 16 <= evenPixels; i += 16) {
+        __m128i h = _mm_loadu_si128((const __m128i *)(hi + i));
+        __m128i l = _mm_loadu_si128((const __m128i *)(lo + i));
+        l = _mm_or_si128(_mm_slli_epi16(l, 8), _mm_srli_epi16(l, 8));
+        _mm_storeu_si128((__m128i *)(out + i),     _mm_unpacklo_epi8(l, h));
+        _mm_storeu_si128((__m128i *)(out + i + 8), _mm_unpackhi_epi8(l, h));
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 16 <= evenPixels; i += 16) {
+        uint8x16x2_t v;
+        v.val[0] = vrev16q_u8(vld1q_u8(lo + i));
+        v.val[1] = vld1q_u8(hi + i);
+        vst2q_u8((uint8_t *)(out + i), v);
+    }
+#endif
+
+    for (; i < evenPixels; i += 2) {
+        out[i]     = (uint16_t)((hi[i] << 8)     + lo[i + 1]);
+        out[i + 1] = (uint16_t)((hi[i + 1] << 8) + lo[i]);
+    }
+}
+
+const CelsiusLut &celsiusLut() {
+    static const CelsiusLut *lut = [] {
+        auto *t = new CelsiusLut;
+        for (int r = 0; r < kRawLevels; r++) t->celsius[r] = (float)rawToCelsius(r);
+        return t;
+    }();
+    return *lut;
+}
+
+const char *decodeTempBPath() {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#elif defined(__ARM_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+}  // namespace infiray
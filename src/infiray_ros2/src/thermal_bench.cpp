@@ -0,0 +1,394 @@
+// 프레임 처리 커널 마이크로벤치마크
+// 사용법: thermal_bench [반복 횟수] [커널 이름 필터]
+//   예) thermal_bench 500 hotspot
+// 결과는 CSV (kernel,variant,width,height,ns_per_frame,mpix_per_s,bytes_per_frame) 로 stdout 에 출력한다.
+// variant 중 이전 구현을 그대로 옮긴 것은 baseline_ 으로 시작한다.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "cv_bridge/cv_bridge.h"
+#include "cv_bridge/cv_mat_sensor_msgs_image_type_adapter.hpp"
+
+#include "infiray_ros2/blob_tracker.hpp"
+#include "infiray_ros2/device_policy.hpp"
+#include "infiray_ros2/fire_detector.hpp"
+#include "infiray_ros2/frame_ring.hpp"
+#include "infiray_ros2/frame_source.hpp"
+#include "infiray_ros2/frame_stats.hpp"
+#include "infiray_ros2/hotspot.hpp"
+#include "infiray_ros2/palette.hpp"
+#include "infiray_ros2/temp_codec.hpp"
+
+using namespace infiray;
+
+struct Resolution { int w, h; };
+static const Resolution kResolutions[] = {{256, 192}, {384, 288}, {640, 512}, {1280, 1024}};
+
+// 최적화가 호출을 지우지 않도록
+static volatile uint32_t g_sink;
+
+static const char *g_filter = nullptr;
+
+static bool enabled(const char *kernel) {
+    return g_filter == nullptr || std::strstr(kernel, g_filter) != nullptr;
+}
+
+template <typename Fn>
+static double timeNsPerIter(int iters, Fn &&fn) {
+    fn();  // 워밍업
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; i++) fn();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+}
+
+static void report(const char *kernel, const char *variant, const Resolution &r, double ns, size_t bytes = 0) {
+    double mpix = (double)r.w * r.h / ns * 1e3;
+    std::printf("%s,%s,%d,%d,%.0f,%.1f,%zu\n", kernel, variant, r.w, r.h, ns, mpix, bytes);
+}
+
+// SIMD 디코더가 스칼라 기준 구현과 비트 단위로 같은지 확인 (꼬리 처리 포함)
+static bool verifyDecode() {
+    std::mt19937 rng(7);
+    for (size_t n : {(size_t)0, (size_t)1, (size_t)2, (size_t)30, (size_t)33, (size_t)64,
+                     (size_t)1000, (size_t)4097, (size_t)256 * 192, (size_t)1280 * 1024}) {
+        std::vector<uint8_t> buf(n * 2);
+        for (auto &b : buf) b = (uint8_t)rng();
+        std::vector<uint16_t> ref(n, 0xDEAD), simd(n, 0xDEAD);
+        decodeTempBScalar(buf.data(), n, ref.data());
+        decodeTempB(buf.data(), n, simd.data());
+        if (ref != simd) {
+            std::fprintf(stderr, "decodeTempB mismatch at n=%zu\n", n);
+            return false;
+        }
+    }
+    return true;
+}
+
+// ---- 이전 구현 (fixed_fast 초기 버전의 메인 루프에서 그대로 옮김) ----
+
+// Y 평면 30x30 boxFilter 최댓값 위치의 온도 평균
+static double baselineHotspot(const cv::Mat &y, const uint16_t *tempBuf, cv::Mat &avgMat) {
+    const int localW = y.cols, localH = y.rows;
+    cv::boxFilter(y, avgMat, CV_8U, cv::Size(30, 30));
+
+    double minVal, maxVal;
+    cv::Point minLoc, maxLoc;
+    cv::minMaxLoc(avgMat, &minVal, &maxVal, &minLoc, &maxLoc);
+
+    int rectX = std::max(0, maxLoc.x - 15);
+    int rectY = std::max(0, maxLoc.y - 15);
+    if (rectX + 30 > localW) rectX = localW - 30;
+    if (rectY + 30 > localH) rectY = localH - 30;
+
+    long long sumTemp = 0;
+    int count = 0;
+    for (int ty = rectY; ty < rectY + 30; ty++) {
+        for (int tx = rectX; tx < rectX + 30; tx++) {
+            sumTemp += tempBuf[ty * localW + tx];
+            count++;
+        }
+    }
+    return rawToCelsius((double)sumTemp / count);
+}
+
+// 오버레이: 사각형 + 온도 글자 (scale 배 확대 좌표)
+static void drawOverlay(cv::Mat &displayMat, const Hotspot &hot, double scale, double fontScale) {
+    cv::Rect hotZone((int)(hot.x * scale), (int)(hot.y * scale), (int)(hot.w * scale), (int)(hot.h * scale));
+    cv::rectangle(displayMat, hotZone, cv::Scalar(0, 255, 0), 2);
+    char textBuf[64];
+    snprintf(textBuf, sizeof(textBuf), "Max: %.1f C", hot.celsius);
+    cv::Point textLoc(hotZone.x, hotZone.y - 10);
+    if (textLoc.y < 20) textLoc.y = hotZone.y + hotZone.height + 25;
+    cv::putText(displayMat, textBuf, textLoc, cv::FONT_HERSHEY_SIMPLEX, fontScale, cv::Scalar(0, 255, 0), 1);
+}
+
+static void benchResolution(const Resolution &r, int iters) {
+    SyntheticSourceConfig cfg;
+    cfg.width = r.w;
+    cfg.height = r.h;
+    SyntheticFrameSource synth(cfg);
+    synth.renderFrame(0);
+
+    const size_t numPixels = (size_t)r.w * r.h;
+    const uint8_t *sdkTemp = synth.sdkTempFrame().data();
+    const uint16_t *temp = synth.tempFrame().data();
+    cv::Mat y(r.h, r.w, CV_8UC1, (void *)synth.yuvFrame().data());
+
+    // ---- tempCallBack 디코딩 ----
+    if (enabled("decode")) {
+        std::vector<uint16_t> out(numPixels);
+        report("decode", "scalar", r, timeNsPerIter(iters, [&] {
+            decodeTempBScalar(sdkTemp, numPixels, out.data());
+            g_sink = out[numPixels / 2];
+        }));
+        report("decode", decodeTempBPath(), r, timeNsPerIter(iters, [&] {
+            decodeTempB(sdkTemp, numPixels, out.data());
+            g_sink = out[numPixels / 2];
+        }));
+    }
+
+    // ---- videoCallBack 복사 (SDK I420 버퍼 -> 링 슬롯) ----
+    if (enabled("capture")) {
+        const uint8_t *yuv = synth.yuvFrame().data();
+        const size_t yuvBytes = numPixels * 3 / 2;
+        std::vector<uint8_t> vec;
+        report("capture", "baseline_vector_yuv420", r, timeNsPerIter(iters, [&] {
+            vec.clear();  // 이전 구현: 매 프레임 resize (0 채우기) 후 전체 복사
+            vec.resize(yuvBytes);
+            std::memcpy(vec.data(), yuv, yuvBytes);
+            g_sink = vec[numPixels / 2];
+        }), yuvBytes);
+        FrameRing<uint8_t> ring;
+        ring.reserve(yuvBytes);
+        for (bool yOnly : {false, true}) {
+            const size_t bytes = yOnly ? numPixels : yuvBytes;
+            report("capture", yOnly ? "ring_y_only" : "ring_yuv420", r, timeNsPerIter(iters, [&] {
+                auto &slot = ring.writeSlot(bytes);
+                std::memcpy(slot.data.data(), yuv, bytes);
+                ring.publish();
+                g_sink = ring.acquireLatest()->data[numPixels / 2];
+            }), bytes);
+        }
+    }
+
+    // ---- 고온 영역 탐색 ----
+    if (enabled("hotspot")) {
+        cv::Mat avgMat;
+        report("hotspot", "baseline_boxfilter_y", r, timeNsPerIter(iters, [&] {
+            g_sink = (uint32_t)baselineHotspot(y, temp, avgMat);
+        }));
+
+        HotspotEngine engine;
+        Hotspot hs[4];
+        report("hotspot", "sat_top1_30", r, timeNsPerIter(iters, [&] {
+            engine.build(temp, r.w, r.h);
+            engine.topK(30, 30, 1, hs);
+            g_sink = (uint32_t)hs[0].x;
+        }));
+        report("hotspot", "sat_top4_30_top1_60", r, timeNsPerIter(iters, [&] {
+            engine.build(temp, r.w, r.h);
+            engine.topK(30, 30, 4, hs);
+            engine.topK(60, 60, 1, hs);
+            g_sink = (uint32_t)hs[0].x;
+        }));
+    }
+
+    // ---- 픽셀 단위 화재 검출 (상태 갱신 + 마스크) ----
+    if (enabled("fire")) {
+        FireDetector detector;
+        uint64_t captureNs = 0;
+        detector.update(temp, r.w, r.h, captureNs);  // 첫 프레임은 기준선 초기화
+        report("fire", "baseline_threshold", r, timeNsPerIter(iters, [&] {
+            // 이전 판정: 창 평균 하나에 대한 celsius > 80
+            g_sink = rawToCelsius(temp[numPixels / 2]) > 80.0;
+        }));
+        report("fire", "ema_rise_hysteresis", r, timeNsPerIter(iters, [&] {
+            captureNs += 33333333;
+            g_sink = (uint32_t)detector.update(temp, r.w, r.h, captureNs).firePixels;
+        }));
+    }
+
+    // ---- 고온 덩어리 분할 + 추적 ----
+    if (enabled("blobs")) {
+        BlobTracker tracker;
+        uint64_t captureNs = 0;
+        report("blobs", "runs_unionfind_track", r, timeNsPerIter(iters, [&] {
+            captureNs += 33333333;
+            g_sink = (uint32_t)tracker.update(temp, r.w, r.h, captureNs).size();
+        }));
+    }
+
+    // ---- 전체/ROI 온도 통계 (ROI 수를 늘려도 거의 평탄해야 한다) ----
+    if (enabled("stats")) {
+        for (int numRois : {0, 8, 32}) {
+            std::vector<StatsRoi> rois;
+            for (int i = 0; i < numRois; i++) {
+                const float x = (float)((i * 37) % std::max(1, r.w - r.w / 8));
+                const float y = (float)((i * 53) % std::max(1, r.h - r.h / 8));
+                const float w = r.w / 8.0f, h = r.h / 8.0f;
+                rois.push_back({"roi", {x, y, x + w, y, x + w, y + h, x, y + h}});
+            }
+            FrameStatsEngine engine;
+            engine.configure(rois, {50.0, 90.0, 99.0});
+            const std::string variant = "rois_" + std::to_string(numRois);
+            report("stats", variant.c_str(), r, timeNsPerIter(iters, [&] {
+                engine.update(temp, r.w, r.h);
+                g_sink = (uint32_t)engine.frame().maxCelsius;
+            }));
+        }
+    }
+
+    // ---- 프레임 전체 raw -> 섭씨 ----
+    if (enabled("celsius")) {
+        std::vector<float> out(numPixels);
+        report("celsius", "formula", r, timeNsPerIter(iters, [&] {
+            for (size_t i = 0; i < numPixels; i++) out[i] = (float)rawToCelsius(temp[i]);
+            g_sink = (uint32_t)out[numPixels / 2];
+        }));
+        const float *lut = celsiusLut().celsius;
+        report("celsius", "lut", r, timeNsPerIter(iters, [&] {
+            for (size_t i = 0; i < numPixels; i++) out[i] = lut[clampRaw(temp[i])];
+            g_sink = (uint32_t)out[numPixels / 2];
+        }));
+        // 장치 정책별 디코딩 + 변환 (같은 커널이 장치마다 따로 컴파일된다)
+        std::vector<uint16_t> raw(numPixels);
+        report("celsius", DeviceB::kName, r, timeNsPerIter(iters, [&] {
+            decodeFrame<DeviceB>(sdkTemp, numPixels, raw.data(), out.data());
+            g_sink = (uint32_t)out[numPixels / 2];
+        }));
+        report("celsius", DeviceIrcNet::kName, r, timeNsPerIter(iters, [&] {
+            decodeFrame<DeviceIrcNet>((const uint8_t *)temp, numPixels, raw.data(), out.data());
+            g_sink = (uint32_t)out[numPixels / 2];
+        }));
+    }
+
+    // ---- 컬러맵 + 오버레이 렌더 ----
+    HotspotEngine engine;
+    Hotspot hot;
+    engine.build(temp, r.w, r.h);
+    engine.topK(30, 30, 1, &hot);
+
+    cv::Mat nativeMat, scaledMat, yResized;
+    cv::cvtColor(y, nativeMat, cv::COLOR_GRAY2BGR);
+    cv::resize(y, yResized, cv::Size(), 2.0, 2.0, cv::INTER_NEAREST);
+    cv::cvtColor(yResized, scaledMat, cv::COLOR_GRAY2BGR);
+
+    if (enabled("render")) {
+        // [수정점 2] 이전: 2배 확대 후 렌더
+        report("render", "baseline_resize2x_gray", r, timeNsPerIter(iters, [&] {
+            cv::resize(y, yResized, cv::Size(), 2.0, 2.0, cv::INTER_NEAREST);
+            cv::cvtColor(yResized, scaledMat, cv::COLOR_GRAY2BGR);
+            drawOverlay(scaledMat, hot, 2.0, 0.8);
+            g_sink = scaledMat.data[0];
+        }));
+        report("render", "native_gray", r, timeNsPerIter(iters, [&] {
+            cv::cvtColor(y, nativeMat, cv::COLOR_GRAY2BGR);
+            drawOverlay(nativeMat, hot, 1.0, 0.4);
+            g_sink = nativeMat.data[0];
+        }));
+        report("render", "native_inferno", r, timeNsPerIter(iters, [&] {
+            cv::applyColorMap(y, nativeMat, cv::COLORMAP_INFERNO);
+            drawOverlay(nativeMat, hot, 1.0, 0.4);
+            g_sink = nativeMat.data[0];
+        }));
+        // 화재 마스크를 겹치는 경우 (예전: 팔레트 패스 + setTo 패스)
+        cv::Mat mask(r.h, r.w, CV_8UC1, cv::Scalar(0));
+        cv::rectangle(mask, cv::Rect(r.w / 4, r.h / 4, r.w / 8, r.h / 8), cv::Scalar(255), cv::FILLED);
+        report("render", "native_inferno_mask", r, timeNsPerIter(iters, [&] {
+            cv::applyColorMap(y, nativeMat, cv::COLORMAP_INFERNO);
+            nativeMat.setTo(cv::Scalar(0, 0, 255), mask);
+            drawOverlay(nativeMat, hot, 1.0, 0.4);
+            g_sink = nativeMat.data[0];
+        }));
+
+        // 팔레트 LUT + 마스크 합성 한 패스 (renderPalette8 / renderPaletteRaw)
+        cv::Mat ramp(1, 256, CV_8UC1), rampBgr;
+        for (int i = 0; i < 256; i++) ramp.at<uint8_t>(0, i) = (uint8_t)i;
+        cv::applyColorMap(ramp, rampBgr, cv::COLORMAP_INFERNO);
+        const Palette8 inferno = paletteFromBgr(rampBgr.ptr<uint8_t>(0));
+        PaletteRaw infernoRaw;
+        buildRawPalette(inferno, celsiusTable<DeviceB>(), DeviceB::kRawLevels, 0.0f, 120.0f, infernoRaw);
+        cv::Mat fusedMat(r.h, r.w, CV_8UC3);
+        report("render", "fused_palette8_inferno", r, timeNsPerIter(iters, [&] {
+            renderPalette8(y.data, y.step, r.w, r.h, inferno, nullptr, 0, 0, fusedMat.data, fusedMat.step);
+            drawOverlay(fusedMat, hot, 1.0, 0.4);
+            g_sink = fusedMat.data[0];
+        }));
+        report("render", "fused_palette8_inferno_mask", r, timeNsPerIter(iters, [&] {
+            renderPalette8(y.data, y.step, r.w, r.h, inferno, mask.data, mask.step, packBgr(0, 0, 255),
+                           fusedMat.data, fusedMat.step);
+            drawOverlay(fusedMat, hot, 1.0, 0.4);
+            g_sink = fusedMat.data[0];
+        }));
+        report("render", "fused_raw14_inferno", r, timeNsPerIter(iters, [&] {
+            renderPaletteRaw(temp, (size_t)r.w * sizeof(uint16_t), r.w, r.h, infernoRaw, nullptr, 0, 0,
+                             fusedMat.data, fusedMat.step);
+            drawOverlay(fusedMat, hot, 1.0, 0.4);
+            g_sink = fusedMat.data[0];
+        }));
+    }
+
+    // ---- 오버레이 압축 (무선 링크용) ----
+    if (enabled("encode")) {
+        cv::Mat inferno;
+        cv::applyColorMap(y, inferno, cv::COLORMAP_INFERNO);
+        drawOverlay(inferno, hot, 1.0, 0.4);
+        std::vector<uchar> buf;  // 크기는 측정이 끝난 뒤 읽는다 (마지막 인코딩 결과)
+        for (int q : {60, 80, 95}) {
+            const std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, q};
+            const std::string variant = "jpeg_q" + std::to_string(q);
+            const double ns = timeNsPerIter(iters, [&] {
+                cv::imencode(".jpg", inferno, buf, params);
+                g_sink = buf[0];
+            });
+            report("encode", variant.c_str(), r, ns, buf.size());
+        }
+        for (int level : {1, 6}) {
+            const std::vector<int> params = {cv::IMWRITE_PNG_COMPRESSION, level};
+            const std::string variant = "png_l" + std::to_string(level);
+            const double ns = timeNsPerIter(iters, [&] {
+                cv::imencode(".png", inferno, buf, params);
+                g_sink = buf[0];
+            });
+            report("encode", variant.c_str(), r, ns, buf.size());
+        }
+    }
+
+    // ---- 발행 메시지 구성 ----
+    if (enabled("msg_build")) {
+        std_msgs::msg::Header header;
+        header.frame_id = "thermal_camera_frame";
+        using Adapter = rclcpp::TypeAdapter<cv_bridge::ROSCvMatContainer, sensor_msgs::msg::Image>;
+
+        // bytes 는 측정 중에 채워지므로 시간을 먼저 받아 둔 뒤 report 한다 (인자 평가 순서는 정해져 있지 않다)
+        size_t bytes = 0;
+        double ns = timeNsPerIter(iters, [&] {
+            auto msg = cv_bridge::CvImage(header, "bgr8", scaledMat).toImageMsg();
+            bytes = msg->data.size();
+            g_sink = msg->data[0];
+        });
+        report("msg_build", "baseline_cv_bridge_resize2x", r, ns, bytes);
+        ns = timeNsPerIter(iters, [&] {
+            auto msg = cv_bridge::CvImage(header, "bgr8", nativeMat).toImageMsg();
+            bytes = msg->data.size();
+            g_sink = msg->data[0];
+        });
+        report("msg_build", "cv_bridge", r, ns, bytes);
+        // 같은 프로세스 구독자: Mat 참조만 넘긴다
+        report("msg_build", "type_adapter_intra", r, timeNsPerIter(iters, [&] {
+            auto container = std::make_unique<cv_bridge::ROSCvMatContainer>(nativeMat, header, false, "bgr8");
+            g_sink = container->cv_mat().data[0];
+        }), 0);
+        // 원격 구독자가 있을 때 RMW 로 넘기기 전 변환
+        sensor_msgs::msg::Image rosMsg;
+        report("msg_build", "type_adapter_to_ros", r, timeNsPerIter(iters, [&] {
+            cv_bridge::ROSCvMatContainer container(nativeMat, header, false, "bgr8");
+            Adapter::convert_to_ros_message(container, rosMsg);
+            g_sink = rosMsg.data[0];
+        }), (size_t)nativeMat.total() * nativeMat.elemSize());
+    }
+}
+
+int main(int argc, char **argv) {
+    const int iters = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    if (argc > 2) g_filter = argv[2];
+
+    if (!verifyDecode()) return 1;
+
+    cv::setNumThreads(1);  // 노드와 같은 조건 (처리 스레드 하나)
+    celsiusLut();
+
+    std::printf("kernel,variant,width,height,ns_per_frame,mpix_per_s,bytes_per_frame\n");
+    for (const auto &r : kResolutions) benchResolution(r, iters);
+    return 0;
+}
@@ -0,0 +1,29 @@
+// ---- 단독 실행 파일 (ros2 run infiray_ros2 thermal_camera_node) ----
+// rclcpp_components 가 만들어 주는 실행 파일과 같이 컴포넌트 라이브러리에서 노드를 올리되,
+// standalone:=true 를 넘겨 ESC/재생 종료 때 이 프로세스를 끝내게 한다.
+// (component_container 에 올리면 standalone 이 false 라 세션만 멈추고 컨테이너는 계속 돈다)
+#include <memory>
+
+#include "class_loader/class_loader.hpp"
+#include "rclcpp/rclcpp.hpp"
+#include "rclcpp_components/node_factory.hpp"
+
+int main(int argc, char **argv) {
+    rclcpp::init(argc, argv);
+    rclcpp::executors::SingleThreadedExecutor exec;
+    {
+        class_loader::ClassLoader loader(THERMAL_COMPONENT_LIBRARY);
+        auto factory = loader.createInstance<rclcpp_components::NodeFactory>(
+            "rclcpp_components::NodeFactoryTemplate<infiray_ros2::ThermalCameraNode>");
+
+        rclcpp::NodeOptions options;
+        options.append_parameter_override("standalone", true);
+        rclcpp_components::NodeInstanceWrapper node = factory->create_node_instance(options);
+        exec.add_node(node.get_node_base_interface());
+        exec.spin();
+        // 라이브러리를 내리기 전에 노드를 먼저 소멸시킨다
+        exec.remove_node(node.get_node_base_interface());
+    }
+    rclcpp::shutdown();
+    return 0;
+}
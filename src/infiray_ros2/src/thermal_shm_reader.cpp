@@ -0,0 +1,78 @@
+// 공유 메모리 링 리더 예제 (노드와 같은 호스트에서 DDS 없이 프레임을 받는다)
+// 사용법: thermal_shm_reader [shm 이름] [초]
+//   예) thermal_shm_reader /infiray_thermal_temp 10
+// 1초마다 받은 프레임 수, 캡처 -> 수신 지연, 놓친 프레임 수를 출력한다. 온도 스트림이면 최고 온도도 출력한다.
+
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "infiray_ros2/shm_ring.hpp"
+#include "infiray_ros2/temp_codec.hpp"
+
+using namespace infiray;
+
+// 노드의 captureNs 는 steady_clock (Linux 에서 CLOCK_MONOTONIC)
+static uint64_t monotonicNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    const std::string name = argc > 1 ? argv[1] : "/infiray_thermal_temp";
+    const int seconds = argc > 2 ? std::atoi(argv[2]) : 0;  // 0 이면 계속
+
+    ShmFrameReader reader(name);
+    std::printf("Waiting for %s ...\n", name.c_str());
+
+    uint64_t frames = 0, lastSeq = 0, skipped = 0, latencySumNs = 0, latencyMaxNs = 0;
+    double maxC = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    auto nextReport = start + std::chrono::seconds(1);
+
+    for (;;) {
+        const auto now = std::chrono::steady_clock::now();
+        if (seconds > 0 && now - start >= std::chrono::seconds(seconds)) break;
+
+        if (reader.waitNew(std::chrono::milliseconds(200))) {
+            ShmFrameView v;
+            if (reader.latest(v)) {
+                const uint64_t lat = monotonicNs() - v.captureNs;
+                // 복사 없이 공유 메모리에서 바로 최고 온도를 찾는다
+                if (v.format == kShmTempRaw) {
+                    const auto *raw = reinterpret_cast<const uint16_t *>(v.data);
+                    const uint16_t m = *std::max_element(raw, raw + v.bytes / 2);
+                    if (reader.valid(v)) maxC = rawToCelsius(m);
+                }
+                if (lastSeq != 0 && v.seq > lastSeq + 1) skipped += v.seq - lastSeq - 1;
+                if (v.seq < lastSeq) skipped = 0;  // 쓰는 쪽이 다시 시작했다
+                lastSeq = v.seq;
+                frames++;
+                latencySumNs += lat;
+                latencyMaxNs = std::max(latencyMaxNs, lat);
+            }
+        }
+
+        if (std::chrono::steady_clock::now() >= nextReport) {
+            nextReport += std::chrono::seconds(1);
+            if (frames > 0) {
+                std::printf("%s: %llu fps, latency mean %.1f us max %.1f us, skipped %llu, torn %llu",
+                            name.c_str(), (unsigned long long)frames, latencySumNs / 1e3 / frames,
+                            latencyMaxNs / 1e3, (unsigned long long)skipped, (unsigned long long)reader.torn());
+                if (maxC != 0.0) std::printf(", max %.1f C", maxC);
+                std::printf("\n");
+            } else {
+                std::printf("%s: no frames\n", name.c_str());
+            }
+            std::fflush(stdout);
+            frames = skipped = latencySumNs = latencyMaxNs = 0;
+        }
+    }
+    return 0;
+}
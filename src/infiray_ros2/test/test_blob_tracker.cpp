@@ -0,0 +1,246 @@
+// BlobTracker 의 분할(run + union-find) 을 BFS 8-연결 brute-force 와 비교하고,
+// 프레임 간 연관이 ID 를 유지/새로 주는지 검사한다.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "infiray_ros2/blob_tracker.hpp"
+#include "infiray_ros2/temp_codec.hpp"
+
+using namespace infiray;
+
+namespace {
+
+constexpr uint64_t kFrameNs = 100000000ull;  // 10 fps
+
+struct BruteBlob {
+    int area = 0;
+    double cx = 0.0, cy = 0.0;
+    int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+    double maxC = 0.0, meanC = 0.0;
+};
+
+std::vector<BruteBlob> bruteBlobs(const std::vector<uint16_t> &temp, int width, int height, double thresholdC,
+                                  int minArea) {
+    const int32_t thr = (int32_t)std::lround((thresholdC + RawConversionB::kelvin) * 30.0);
+    std::vector<char> seen(temp.size(), 0);
+    std::vector<BruteBlob> out;
+    std::vector<int> stack;
+    for (int sy = 0; sy < height; sy++) {
+        for (int sx = 0; sx < width; sx++) {
+            const size_t s = (size_t)sy * width + sx;
+            if (seen[s] || rawToKelvin30(temp[s]) < thr) continue;
+            BruteBlob b;
+            b.x0 = b.x1 = sx;
+            b.y0 = b.y1 = sy;
+            int64_t sumX = 0, sumY = 0, sumK = 0;
+            int32_t maxK = 0;
+            seen[s] = 1;
+            stack.assign(1, (int)s);
+            while (!stack.empty()) {
+                const int i = stack.back();
+                stack.pop_back();
+                const int x = i % width, y = i / width;
+                const int32_t k = rawToKelvin30(temp[i]);
+                b.area++;
+                sumX += x;
+                sumY += y;
+                sumK += k;
+                maxK = std::max(maxK, k);
+                b.x0 = std::min(b.x0, x);
+                b.x1 = std::max(b.x1, x);
+                b.y0 = std::min(b.y0, y);
+                b.y1 = std::max(b.y1, y);
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        const int nx = x + dx, ny = y + dy;
+                        if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+                        const size_t n = (size_t)ny * width + nx;
+                        if (seen[n] || rawToKelvin30(temp[n]) < thr) continue;
+                        seen[n] = 1;
+                        stack.push_back((int)n);
+                    }
+                }
+            }
+            if (b.area < minArea) continue;
+            b.cx = (double)sumX / b.area;
+            b.cy = (double)sumY / b.area;
+            b.maxC = kelvin30ToCelsius(maxK);
+            b.meanC = kelvin30ToCelsius((double)sumK / b.area);
+            out.push_back(b);
+        }
+    }
+    return out;
+}
+
+// 배경 (임계값 아래) + 임계값을 넘는 사각형/원 덩어리 몇 개 + 외딴 뜨거운 점 (minArea 로 걸러짐)
+std::vector<uint16_t> makeFrame(int width, int height, std::mt19937 &rng) {
+    std::vector<uint16_t> temp((size_t)width * height);
+    std::uniform_real_distribution<double> bg(20.0, 59.0), hot(60.5, 250.0);
+    for (auto &v : temp) v = celsiusToRaw(bg(rng));
+    std::uniform_int_distribution<int> px(0, width - 1), py(0, height - 1), size(1, 9);
+    for (int blob = 0; blob < 10; blob++) {
+        const int cx = px(rng), cy = py(rng), rx = size(rng), ry = size(rng);
+        const bool disc = rng() % 2;
+        for (int y = std::max(0, cy - ry); y <= std::min(height - 1, cy + ry); y++) {
+            for (int x = std::max(0, cx - rx); x <= std::min(width - 1, cx + rx); x++) {
+                const double u = (double)(x - cx) / rx, v = (double)(y - cy) / ry;
+                if (disc && u * u + v * v > 1.0) continue;
+                temp[(size_t)y * width + x] = celsiusToRaw(hot(rng));
+            }
+        }
+    }
+    for (int i = 0; i < 15; i++) temp[(size_t)py(rng) * width + px(rng)] = celsiusToRaw(hot(rng));
+    return temp;
+}
+
+// w x h 사각형 덩어리를 (x, y) 에 그린 프레임
+void paintRect(std::vector<uint16_t> &temp, int width, int x, int y, int w, int h, double celsius) {
+    for (int yy = y; yy < y + h; yy++) {
+        for (int xx = x; xx < x + w; xx++) temp[(size_t)yy * width + xx] = celsiusToRaw(celsius);
+    }
+}
+
+}  // namespace
+
+TEST(BlobTracker, SegmentationMatchesBruteForce) {
+    std::mt19937 rng(13);
+    BlobTrackerConfig cfg;
+    cfg.maxBlobs = 1000;  // 면적 순 자르기 없이 전부 비교
+    for (int trial = 0; trial < 30; trial++) {
+        const int width = 16 + (int)(rng() % 90), height = 12 + (int)(rng() % 70);
+        const std::vector<uint16_t> temp = makeFrame(width, height, rng);
+        BlobTracker tracker(cfg);
+        std::vector<TrackedBlob> got = tracker.update(temp.data(), width, height, kFrameNs);
+        std::vector<BruteBlob> want = bruteBlobs(temp, width, height, cfg.thresholdC, cfg.minArea);
+
+        ASSERT_EQ(got.size(), want.size()) << "trial " << trial << " " << width << "x" << height;
+        // 외접 사각형의 왼쪽 위 -> 면적 순으로 맞춰 비교한다
+        std::sort(got.begin(), got.end(), [](const TrackedBlob &a, const TrackedBlob &b) {
+            return std::make_tuple(a.y, a.x, a.area) < std::make_tuple(b.y, b.x, b.area);
+        });
+        std::sort(want.begin(), want.end(), [](const BruteBlob &a, const BruteBlob &b) {
+            return std::make_tuple(a.y0, a.x0, a.area) < std::make_tuple(b.y0, b.x0, b.area);
+        });
+        for (size_t i = 0; i < want.size(); i++) {
+            const TrackedBlob &g = got[i];
+            const BruteBlob &w = want[i];
+            EXPECT_EQ(g.area, w.area) << "trial " << trial << " blob " << i;
+            EXPECT_EQ(g.x, w.x0);
+            EXPECT_EQ(g.y, w.y0);
+            EXPECT_EQ(g.w, w.x1 - w.x0 + 1);
+            EXPECT_EQ(g.h, w.y1 - w.y0 + 1);
+            EXPECT_NEAR(g.cx, w.cx, 1e-3);
+            EXPECT_NEAR(g.cy, w.cy, 1e-3);
+            EXPECT_NEAR(g.maxCelsius, w.maxC, 1e-3);
+            EXPECT_NEAR(g.meanCelsius, w.meanC, 1e-3);
+        }
+    }
+}
+
+// 대각선으로만 닿는 두 사각형은 8-연결이라 한 덩어리
+TEST(BlobTracker, DiagonalTouchIsOneBlob) {
+    const int width = 20, height = 20;
+    std::vector<uint16_t> temp((size_t)width * height, celsiusToRaw(25.0));
+    paintRect(temp, width, 2, 2, 5, 5, 100.0);
+    paintRect(temp, width, 7, 7, 5, 5, 100.0);
+    BlobTrackerConfig cfg;
+    BlobTracker tracker(cfg);
+    const auto &blobs = tracker.update(temp.data(), width, height, kFrameNs);
+    ASSERT_EQ(blobs.size(), 1u);
+    EXPECT_EQ(blobs[0].area, 50);
+    EXPECT_EQ(blobs[0].w, 10);
+    EXPECT_EQ(blobs[0].h, 10);
+}
+
+// 서로 반대로 움직이는 두 덩어리는 프레임마다 같은 ID 를 유지한다
+TEST(BlobTracker, MovingBlobsKeepIds) {
+    const int width = 160, height = 80;
+    BlobTrackerConfig cfg;
+    BlobTracker tracker(cfg);
+    uint32_t idA = 0, idB = 0;
+    for (int f = 0; f < 30; f++) {
+        std::vector<uint16_t> temp((size_t)width * height, celsiusToRaw(25.0));
+        const int ax = 10 + 3 * f, bx = 140 - 3 * f;  // 한 번 지나치며 x 가 엇갈린다 (y 는 떨어져 있음)
+        paintRect(temp, width, ax, 10, 6, 6, 120.0);
+        paintRect(temp, width, bx, 50, 8, 5, 90.0);
+        const auto &blobs = tracker.update(temp.data(), width, height, (uint64_t)(f + 1) * kFrameNs);
+        ASSERT_EQ(blobs.size(), 2u) << "frame " << f;
+        const TrackedBlob &a = blobs[0].cy < blobs[1].cy ? blobs[0] : blobs[1];
+        const TrackedBlob &b = blobs[0].cy < blobs[1].cy ? blobs[1] : blobs[0];
+        EXPECT_NEAR(a.cx, ax + 2.5, 1e-4);
+        EXPECT_NEAR(b.cx, bx + 3.5, 1e-4);
+        if (f == 0) {
+            idA = a.id;
+            idB = b.id;
+            EXPECT_NE(idA, idB);
+        } else {
+            EXPECT_EQ(a.id, idA) << "frame " << f;
+            EXPECT_EQ(b.id, idB) << "frame " << f;
+            EXPECT_EQ(a.age, (uint32_t)f + 1);
+        }
+    }
+    // 속도는 픽셀/초 (3 px / 100 ms)
+    const auto &last = tracker.visible();
+    for (const auto &t : last) EXPECT_NEAR(std::fabs(t.vx), 30.0f, 1e-2);
+}
+
+// 몇 프레임 안 보였다가 연관 거리 안에서 다시 보이면 같은 ID, 거리 밖이면 새 ID
+TEST(BlobTracker, ReappearanceInsideGateKeepsIdOutsideGetsNewId) {
+    const int width = 200, height = 60;
+    BlobTrackerConfig cfg;
+    ASSERT_LT(cfg.maxMatchDistPx, 100.0);
+    const std::vector<uint16_t> empty((size_t)width * height, celsiusToRaw(25.0));
+
+    auto frameAt = [&](int x) {
+        std::vector<uint16_t> temp = empty;
+        paintRect(temp, width, x, 20, 6, 6, 100.0);
+        return temp;
+    };
+
+    BlobTracker tracker(cfg);
+    uint64_t ns = 0;
+    // 멈춰 있는 덩어리 (속도 0) 로 시작한다
+    uint32_t id = 0;
+    for (int f = 0; f < 3; f++) {
+        const auto &blobs = tracker.update(frameAt(20).data(), width, height, ns += kFrameNs);
+        ASSERT_EQ(blobs.size(), 1u);
+        if (f == 0) id = blobs[0].id;
+        EXPECT_EQ(blobs[0].id, id);
+    }
+    for (int f = 0; f < 2; f++) EXPECT_TRUE(tracker.update(empty.data(), width, height, ns += kFrameNs).empty());
+    {
+        const auto &blobs = tracker.update(frameAt(25).data(), width, height, ns += kFrameNs);
+        ASSERT_EQ(blobs.size(), 1u);
+        EXPECT_EQ(blobs[0].id, id);  // 5 px 떨어짐: 같은 덩어리
+    }
+
+    for (int f = 0; f < 2; f++) EXPECT_TRUE(tracker.update(empty.data(), width, height, ns += kFrameNs).empty());
+    const auto &blobs = tracker.update(frameAt(25 + 100).data(), width, height, ns += kFrameNs);
+    ASSERT_EQ(blobs.size(), 1u);
+    EXPECT_NE(blobs[0].id, id);  // 100 px 떨어짐: 새 덩어리
+    EXPECT_GT(blobs[0].id, id);
+    EXPECT_EQ(blobs[0].age, 1u);
+}
+
+// maxMissedFrames 보다 오래 안 보이면 같은 자리로 돌아와도 새 ID
+TEST(BlobTracker, TrackExpiresAfterMaxMissedFrames) {
+    const int width = 60, height = 40;
+    BlobTrackerConfig cfg;
+    std::vector<uint16_t> frame((size_t)width * height, celsiusToRaw(25.0));
+    const std::vector<uint16_t> empty = frame;
+    paintRect(frame, width, 20, 10, 6, 6, 100.0);
+
+    BlobTracker tracker(cfg);
+    uint64_t ns = 0;
+    const uint32_t id = tracker.update(frame.data(), width, height, ns += kFrameNs).at(0).id;
+    for (int f = 0; f <= cfg.maxMissedFrames; f++) tracker.update(empty.data(), width, height, ns += kFrameNs);
+    const auto &blobs = tracker.update(frame.data(), width, height, ns += kFrameNs);
+    ASSERT_EQ(blobs.size(), 1u);
+    EXPECT_NE(blobs[0].id, id);
+}
@@ -0,0 +1,164 @@
+// FireDetector 의 픽셀별 상태 (onFrames/offFrames 히스테리시스, 상승폭 판정, 기준선 고정) 를 검사한다.
+// 모든 픽셀이 같은 온도인 작은 프레임을 100 ms 간격으로 넣어 프레임 전체를 한 픽셀처럼 본다.
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "infiray_ros2/fire_detector.hpp"
+#include "infiray_ros2/temp_codec.hpp"
+
+using namespace infiray;
+
+namespace {
+
+constexpr int kW = 8, kH = 8;
+constexpr uint64_t kFrameNs = 100000000ull;  // 10 fps
+
+FireDetectorConfig testConfig() {
+    FireDetectorConfig cfg;
+    cfg.smoothTauS = 1e-3;  // 평활을 사실상 끈다 (프레임 온도 = 평활 온도)
+    return cfg;
+}
+
+class Feeder {
+public:
+    explicit Feeder(const FireDetectorConfig &cfg) : detector_(cfg), frame_((size_t)kW * kH) {}
+
+    const FireResult &feed(double celsius) {
+        const uint16_t raw = celsiusToRaw(celsius);
+        for (auto &v : frame_) v = raw;
+        ns_ += kFrameNs;
+        return detector_.update(frame_.data(), kW, kH, ns_);
+    }
+
+    const FireDetector &detector() const { return detector_; }
+
+private:
+    FireDetector detector_;
+    std::vector<uint16_t> frame_;
+    uint64_t ns_ = 1000000000ull;
+};
+
+}  // namespace
+
+// 한 프레임만 튀는 값은 onFrames 를 채우지 못하므로 화재가 아니다
+TEST(FireDetector, SingleHotFrameDoesNotTrip) {
+    const FireDetectorConfig cfg = testConfig();
+    Feeder f(cfg);
+    f.feed(25.0);
+    const FireResult &spike = f.feed(150.0);
+    EXPECT_EQ(spike.hotPixels, kW * kH);
+    EXPECT_EQ(spike.firePixels, 0);
+    EXPECT_FALSE(spike.detected);
+    for (int i = 0; i < 30; i++) {
+        const FireResult &r = f.feed(25.0);
+        EXPECT_EQ(r.firePixels, 0) << "frame " << i;
+        EXPECT_FALSE(r.detected);
+    }
+}
+
+// onFrames 번째 연속 뜨거운 프레임에서 처음 켜진다
+TEST(FireDetector, TripsAfterOnFrames) {
+    const FireDetectorConfig cfg = testConfig();
+    Feeder f(cfg);
+    f.feed(25.0);
+    for (int i = 1; i < cfg.onFrames; i++) EXPECT_FALSE(f.feed(100.0).detected) << "hot frame " << i;
+    const FireResult &r = f.feed(100.0);
+    EXPECT_TRUE(r.detected);
+    EXPECT_EQ(r.firePixels, kW * kH);
+    EXPECT_FLOAT_EQ(r.confidence, 1.0f);
+    EXPECT_EQ(f.detector().mask()[0], 255);
+}
+
+// 1 C/s 로 천천히 오르는 불: 상승 속도와 절대 기준 아래에서 기준선 대비 상승폭으로 켜진다
+TEST(FireDetector, SlowRiseTripsOnRiseDelta) {
+    const FireDetectorConfig cfg = testConfig();
+    ASSERT_LT(1.0, cfg.riseRateCps);
+    Feeder f(cfg);
+    double c = 25.0;
+    f.feed(c);
+    double trippedAt = -1.0;
+    while (c < 60.0) {
+        c += 0.1;  // 0.1 C / 100 ms
+        if (f.feed(c).detected) {
+            trippedAt = c;
+            break;
+        }
+    }
+    ASSERT_GT(trippedAt, 0.0) << "never tripped";
+    EXPECT_LT(trippedAt, cfg.thresholdC);
+    // 기준선은 25 C 에서 시작해 내려가지 않으므로 상승폭 riseDeltaC 는 25 + riseDeltaC 이상에서만 채워진다
+    EXPECT_GE(trippedAt, 25.0 + cfg.riseDeltaC);
+}
+
+// 해제는 offFrames 연속으로 식은 프레임이 있어야 한다
+TEST(FireDetector, ReleaseTakesOffFrames) {
+    const FireDetectorConfig cfg = testConfig();
+    Feeder f(cfg);
+    f.feed(25.0);
+    for (int i = 0; i < cfg.onFrames; i++) f.feed(100.0);
+    ASSERT_TRUE(f.feed(100.0).detected);
+
+    for (int i = 1; i < cfg.offFrames; i++) EXPECT_TRUE(f.feed(25.0).detected) << "cool frame " << i;
+    const FireResult &r = f.feed(25.0);
+    EXPECT_FALSE(r.detected);
+    EXPECT_EQ(r.firePixels, 0);
+    EXPECT_EQ(f.detector().mask()[0], 0);
+}
+
+// 해제 조건이 중간에 끊기면 해제 횟수를 처음부터 다시 센다
+TEST(FireDetector, InterruptedCoolingRestartsCount) {
+    const FireDetectorConfig cfg = testConfig();
+    Feeder f(cfg);
+    f.feed(25.0);
+    for (int i = 0; i <= cfg.onFrames; i++) f.feed(100.0);
+    for (int i = 1; i < cfg.offFrames; i++) f.feed(25.0);
+    EXPECT_TRUE(f.feed(100.0).detected);
+    for (int i = 1; i < cfg.offFrames; i++) EXPECT_TRUE(f.feed(25.0).detected) << "cool frame " << i;
+    EXPECT_FALSE(f.feed(25.0).detected);
+}
+
+// 상승폭으로 켜진 불을 기준선 시간 상수의 몇 배 동안 유지해도 기준선이 따라가 꺼지지 않는다
+TEST(FireDetector, BaselineDoesNotAbsorbActiveFire) {
+    FireDetectorConfig cfg = testConfig();
+    cfg.baselineTauS = 5.0;  // 흡수된다면 몇 초 안에 드러나도록 짧게
+    Feeder f(cfg);
+    f.feed(25.0);
+    const double fireC = 25.0 + cfg.riseDeltaC + 5.0;  // thresholdC 아래
+    ASSERT_LT(fireC, cfg.releaseC);
+    for (int i = 0; i < cfg.onFrames; i++) f.feed(fireC);
+    ASSERT_TRUE(f.feed(fireC).detected);
+
+    const int frames = (int)(20.0 * cfg.baselineTauS * 1e9 / kFrameNs);
+    for (int i = 0; i < frames; i++) ASSERT_TRUE(f.feed(fireC).detected) << "frame " << i;
+}
+
+// 대조: 뜨겁지 않은 픽셀의 기준선은 따라가므로 같은 온도로 천천히 오른 뒤에는 상승폭으로 켜지지 않는다
+TEST(FireDetector, BaselineTracksNormalPixels) {
+    FireDetectorConfig cfg = testConfig();
+    cfg.baselineTauS = 1.0;
+    Feeder f(cfg);
+    double c = 25.0;
+    f.feed(c);
+    while (c < 25.0 + cfg.riseDeltaC + 5.0) {
+        c += 0.01;  // 0.1 C/s: 기준선 지연 (속도 * tau) 이 riseDeltaReleaseC 보다 훨씬 작다
+        EXPECT_FALSE(f.feed(c).detected) << c << " C";
+    }
+}
+
+// 해상도가 바뀌면 새 프레임 온도로 상태를 다시 시작한다 (이전 해상도의 화재 상태를 끌고 오지 않음)
+TEST(FireDetector, ResolutionChangeResetsState) {
+    const FireDetectorConfig cfg = testConfig();
+    FireDetector detector(cfg);
+    std::vector<uint16_t> hot((size_t)kW * kH, celsiusToRaw(100.0)), cold((size_t)kW * kH, celsiusToRaw(25.0));
+    uint64_t ns = kFrameNs;
+    detector.update(cold.data(), kW, kH, ns);
+    for (int i = 0; i <= cfg.onFrames; i++) detector.update(hot.data(), kW, kH, ns += kFrameNs);
+    ASSERT_TRUE(detector.result().detected);
+
+    std::vector<uint16_t> other((size_t)4 * 4, celsiusToRaw(100.0));
+    EXPECT_FALSE(detector.update(other.data(), 4, 4, ns += kFrameNs).detected);
+    EXPECT_EQ(detector.width(), 4);
+    EXPECT_EQ(detector.mask()[0], 0);
+}
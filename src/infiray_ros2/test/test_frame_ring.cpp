@@ -0,0 +1,105 @@
+// FrameRing: 생산자/소비자 스레드 한 쌍에서 덮어쓴/가져간 프레임 수와 프레임 내용을 확인한다.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "infiray_ros2/frame_ring.hpp"
+
+using namespace infiray;
+
+namespace {
+
+// 프레임 내용은 seq 로 채워, 소비자가 읽는 동안 생산자가 같은 슬롯을 건드리면 드러나게 한다
+void fillFrame(FrameSlot<uint32_t> &slot, uint32_t seq) {
+    for (auto &v : slot.data) v = seq;
+}
+
+bool frameIntact(const FrameSlot<uint32_t> &slot) {
+    for (uint32_t v : slot.data) {
+        if (v != (uint32_t)slot.seq) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+TEST(FrameRing, SingleThreadOverwriteCount) {
+    FrameRing<uint32_t> ring(16);
+    EXPECT_FALSE(ring.hasNew());
+    EXPECT_EQ(ring.acquireLatest(), nullptr);
+
+    for (uint32_t i = 1; i <= 5; i++) {
+        fillFrame(ring.writeSlot(16), i);
+        ring.publish();
+    }
+    // 가져가기 전에 네 번 덮어썼다
+    EXPECT_EQ(ring.published(), 5u);
+    EXPECT_EQ(ring.overwritten(), 4u);
+
+    const FrameSlot<uint32_t> *frame = ring.acquireLatest();
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->seq, 5u);
+    EXPECT_TRUE(frameIntact(*frame));
+    EXPECT_FALSE(ring.hasNew());
+    EXPECT_EQ(ring.acquireLatest(), nullptr);
+    EXPECT_EQ(ring.current().seq, 5u);
+}
+
+TEST(FrameRing, GrowsOnlyPastReservation) {
+    FrameRing<uint32_t> ring(64);
+    const uint64_t allocs = frameAllocStats().allocations;
+    for (int i = 0; i < 10; i++) {
+        ring.writeSlot(i % 2 ? 64 : 32);
+        ring.publish();
+        ring.acquireLatest();
+    }
+    EXPECT_EQ(ring.grown(), 0u);
+    EXPECT_EQ(frameAllocStats().allocations, allocs);
+    ring.writeSlot(65);
+    EXPECT_EQ(ring.grown(), 1u);
+}
+
+// 생산자는 쉬지 않고, 소비자는 가끔 늦게 가져간다.
+// 발행한 모든 프레임은 정확히 한 번 소비되거나 덮어쓰였어야 하고, 소비한 seq 는 늘어나기만 한다.
+TEST(FrameRing, ProducerConsumerCountsAddUp) {
+    constexpr uint32_t kFrames = 200000;
+    constexpr size_t kElems = 256;
+    FrameRing<uint32_t> ring(kElems);
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        for (uint32_t i = 1; i <= kFrames; i++) {
+            FrameSlot<uint32_t> &slot = ring.writeSlot(kElems);
+            fillFrame(slot, i);
+            ring.publish();
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint64_t consumed = 0, lastSeq = 0, torn = 0, outOfOrder = 0;
+    auto consume = [&] {
+        const FrameSlot<uint32_t> *frame = ring.acquireLatest();
+        if (frame == nullptr) return;
+        consumed++;
+        if (frame->seq <= lastSeq) outOfOrder++;
+        if (!frameIntact(*frame)) torn++;
+        lastSeq = frame->seq;
+    };
+    uint64_t spin = 0;
+    while (!done.load(std::memory_order_acquire)) {
+        consume();
+        if (++spin % 64 == 0) std::this_thread::yield();  // 가끔 밀려서 덮어쓰기가 생기게
+    }
+    producer.join();
+    consume();  // 마지막 발행분
+
+    EXPECT_EQ(ring.published(), kFrames);
+    EXPECT_EQ(lastSeq, kFrames);
+    EXPECT_EQ(torn, 0u);
+    EXPECT_EQ(outOfOrder, 0u);
+    EXPECT_EQ(consumed + ring.overwritten(), (uint64_t)kFrames);
+    EXPECT_GT(consumed, 0u);
+    EXPECT_FALSE(ring.hasNew());
+}
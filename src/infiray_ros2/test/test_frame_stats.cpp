@@ -0,0 +1,114 @@
+// FrameStatsEngine: 전체/다각형 ROI 의 최소/최대/평균/분위수를 픽셀을 모아 정렬한 결과와 비교한다.
+// 분위수 p 는 정렬한 값의 max(1, ceil(p/100 * n)) 번째 (1부터).
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "infiray_ros2/frame_stats.hpp"
+#include "infiray_ros2/temp_codec.hpp"
+
+using namespace infiray;
+
+namespace {
+
+// 픽셀 중심이 다각형 안인지 (짝홀 규칙, 엔진과 같은 교차점 식)
+bool insidePolygon(const std::vector<float> &xy, int x, int y) {
+    const float xc = (float)x + 0.5f, yc = (float)y + 0.5f;
+    const size_t n = xy.size() / 2;
+    bool inside = false;
+    for (size_t i = 0, j = n - 1; i < n; j = i++) {
+        const float xi = xy[2 * i], yi = xy[2 * i + 1];
+        const float xj = xy[2 * j], yj = xy[2 * j + 1];
+        if ((yi <= yc) == (yj <= yc)) continue;
+        if (xc < xi + (yc - yi) * (xj - xi) / (yj - yi)) inside = !inside;
+    }
+    return inside;
+}
+
+void expectSameAsSorted(std::vector<int32_t> k30, const RegionStats &got, const std::vector<double> &percentiles,
+                        const char *what) {
+    ASSERT_EQ(got.pixels, k30.size()) << what;
+    ASSERT_EQ(got.percentileCelsius.size(), percentiles.size()) << what;
+    if (k30.empty()) return;
+    std::sort(k30.begin(), k30.end());
+    double sum = 0.0;
+    for (int32_t k : k30) sum += k;
+    const auto celsius = [](double k) { return (float)kelvin30ToCelsius(k); };
+
+    EXPECT_FLOAT_EQ(got.minCelsius, celsius(k30.front())) << what;
+    EXPECT_FLOAT_EQ(got.maxCelsius, celsius(k30.back())) << what;
+    EXPECT_NEAR(got.meanCelsius, celsius(sum / k30.size()), 1e-3) << what;
+    for (size_t i = 0; i < percentiles.size(); i++) {
+        const size_t rank = std::max<size_t>(1, (size_t)std::ceil(percentiles[i] / 100.0 * k30.size()));
+        EXPECT_FLOAT_EQ(got.percentileCelsius[i], celsius(k30[rank - 1])) << what << " p" << percentiles[i];
+    }
+}
+
+void checkFrame(FrameStatsEngine &engine, const std::vector<uint16_t> &temp, int width, int height) {
+    engine.update(temp.data(), width, height);
+    std::vector<int32_t> all;
+    std::vector<std::vector<int32_t>> perRoi(engine.roiDefs().size());
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int32_t k = rawToKelvin30(clampRaw(temp[(size_t)y * width + x]));
+            all.push_back(k);
+            for (size_t r = 0; r < perRoi.size(); r++) {
+                if (insidePolygon(engine.roiDefs()[r].xy, x, y)) perRoi[r].push_back(k);
+            }
+        }
+    }
+    expectSameAsSorted(all, engine.frame(), engine.percentiles(), "frame");
+    ASSERT_EQ(engine.rois().size(), perRoi.size());
+    for (size_t r = 0; r < perRoi.size(); r++) {
+        expectSameAsSorted(perRoi[r], engine.rois()[r], engine.percentiles(), engine.roiDefs()[r].name.c_str());
+    }
+}
+
+// 구간 경계(7300) 양쪽 값, 14비트를 넘는 값, 같은 값이 여럿인 경우를 섞는다
+std::vector<uint16_t> makeFrame(int width, int height, std::mt19937 &rng) {
+    std::vector<uint16_t> temp((size_t)width * height);
+    std::uniform_int_distribution<int> wide(0, 0xFFFF), narrow(7250, 7350);
+    for (auto &v : temp) v = (uint16_t)((rng() % 4 == 0) ? wide(rng) : narrow(rng));
+    return temp;
+}
+
+}  // namespace
+
+TEST(FrameStatsEngine, MatchesSortedPixels) {
+    const int width = 97, height = 61;
+    FrameStatsEngine engine;
+    const std::vector<double> percentiles = {99, 0, 50, 90, 100, 12.5};  // 정렬 안 된 입력
+    engine.configure({{"tri", {3.3f, 2.7f, 80.1f, 10.2f, 40.6f, 55.9f}},
+                      {"concave", {10.2f, 10.3f, 60.7f, 10.1f, 30.4f, 25.6f, 60.2f, 50.8f, 10.6f, 50.4f}},
+                      {"clipped", {-20.5f, -10.2f, 30.3f, -5.7f, 25.1f, 20.9f, -15.8f, 30.2f}},
+                      {"outside", {200.f, 200.f, 210.f, 200.f, 205.f, 210.f}}},
+                     percentiles);
+    ASSERT_EQ(engine.percentiles(), (std::vector<double>{0, 12.5, 50, 90, 99, 100}));
+
+    std::mt19937 rng(17);
+    // 같은 엔진으로 여러 프레임: 요약 때 히스토그램을 비우는 것도 함께 확인한다
+    for (int i = 0; i < 4; i++) checkFrame(engine, makeFrame(width, height, rng), width, height);
+    EXPECT_EQ(engine.rois()[3].pixels, 0u);
+}
+
+TEST(FrameStatsEngine, ResolutionChangeRerasterizes) {
+    FrameStatsEngine engine;
+    engine.configure({{"box", {4.5f, 4.5f, 40.5f, 4.5f, 40.5f, 30.5f, 4.5f, 30.5f}}}, {50, 90});
+    std::mt19937 rng(23);
+    checkFrame(engine, makeFrame(64, 48, rng), 64, 48);
+    const size_t runs = engine.runCount();
+    checkFrame(engine, makeFrame(32, 20, rng), 32, 20);
+    EXPECT_NE(engine.runCount(), runs);
+    EXPECT_EQ(engine.rois()[0].pixels, (uint32_t)(32 - 4) * (20 - 4));  // 중심 4.5 부터, 프레임 끝에서 잘림
+}
+
+TEST(FrameStatsEngine, SkipsDegenerateRoi) {
+    FrameStatsEngine engine;
+    engine.configure({{"line", {0.f, 0.f, 10.f, 10.f}}, {"ok", {0.f, 0.f, 8.f, 0.f, 0.f, 8.f}}}, {50});
+    ASSERT_EQ(engine.roiDefs().size(), 1u);
+    EXPECT_EQ(engine.roiDefs()[0].name, "ok");
+}
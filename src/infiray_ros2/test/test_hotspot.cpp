@@ -0,0 +1,133 @@
+// HotspotEngine::topK 를 창 위치를 모두 훑는 brute-force 와 비교한다.
+// 기준: 창 합이 가장 큰 창 (같으면 행 우선 첫 위치), 고른 창과 겹치는 창은 제외하고 반복.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "infiray_ros2/hotspot.hpp"
+#include "infiray_ros2/temp_codec.hpp"
+
+using namespace infiray;
+
+namespace {
+
+std::vector<Hotspot> bruteTopK(const std::vector<uint16_t> &temp, int width, int height, int winW, int winH,
+                               int k) {
+    const int nx = width - winW + 1, ny = height - winH + 1;
+    std::vector<int64_t> sums((size_t)nx * ny);
+    for (int y = 0; y < ny; y++) {
+        for (int x = 0; x < nx; x++) {
+            int64_t s = 0;
+            for (int dy = 0; dy < winH; dy++) {
+                for (int dx = 0; dx < winW; dx++) s += rawToKelvin30(clampRaw(temp[(size_t)(y + dy) * width + x + dx]));
+            }
+            sums[(size_t)y * nx + x] = s;
+        }
+    }
+    std::vector<bool> blocked(sums.size(), false);
+    std::vector<Hotspot> out;
+    while ((int)out.size() < k) {
+        int best = -1;
+        for (size_t i = 0; i < sums.size(); i++) {
+            if (!blocked[i] && (best < 0 || sums[i] > sums[best])) best = (int)i;
+        }
+        if (best < 0) break;
+        Hotspot h;
+        h.valid = true;
+        h.x = best % nx;
+        h.y = best / nx;
+        h.w = winW;
+        h.h = winH;
+        h.celsius = kelvin30ToCelsius((double)sums[best] / ((double)winW * winH));
+        out.push_back(h);
+        for (int y = 0; y < ny; y++) {
+            for (int x = 0; x < nx; x++) {
+                if (std::abs(x - h.x) < winW && std::abs(y - h.y) < winH) blocked[(size_t)y * nx + x] = true;
+            }
+        }
+    }
+    return out;
+}
+
+void expectSameAsBrute(const std::vector<uint16_t> &temp, int width, int height, int winW, int winH, int k) {
+    HotspotEngine engine;
+    engine.build(temp.data(), width, height);
+    std::vector<Hotspot> got(k);
+    got.resize(engine.topK(winW, winH, k, got.data()));
+    const std::vector<Hotspot> want = bruteTopK(temp, width, height, winW, winH, k);
+
+    ASSERT_EQ(got.size(), want.size()) << width << "x" << height << " win " << winW << "x" << winH;
+    for (size_t i = 0; i < want.size(); i++) {
+        EXPECT_EQ(got[i].x, want[i].x) << "rank " << i;
+        EXPECT_EQ(got[i].y, want[i].y) << "rank " << i;
+        EXPECT_EQ(got[i].w, winW);
+        EXPECT_EQ(got[i].h, winH);
+        EXPECT_NEAR(got[i].celsius, want[i].celsius, 1e-9) << "rank " << i;
+    }
+}
+
+// 배경 잡음 + 뜨거운 덩어리 몇 개 (경계 7300 양쪽 값과 14비트를 넘는 값 포함)
+std::vector<uint16_t> makeFrame(int width, int height, std::mt19937 &rng) {
+    std::vector<uint16_t> temp((size_t)width * height);
+    std::uniform_int_distribution<int> noise(7100, 7500);
+    for (auto &v : temp) v = (uint16_t)noise(rng);
+    std::uniform_int_distribution<int> px(0, width - 1), py(0, height - 1), hot(8000, 20000);
+    for (int blob = 0; blob < 6; blob++) {
+        const int cx = px(rng), cy = py(rng), r = 1 + (int)(rng() % 6), value = hot(rng);
+        for (int y = std::max(0, cy - r); y < std::min(height, cy + r); y++) {
+            for (int x = std::max(0, cx - r); x < std::min(width, cx + r); x++) temp[(size_t)y * width + x] = (uint16_t)value;
+        }
+    }
+    return temp;
+}
+
+}  // namespace
+
+TEST(HotspotEngine, TopKMatchesBruteForce) {
+    std::mt19937 rng(5);
+    for (int trial = 0; trial < 20; trial++) {
+        const int width = 20 + (int)(rng() % 60), height = 16 + (int)(rng() % 40);
+        const std::vector<uint16_t> temp = makeFrame(width, height, rng);
+        for (int win : {1, 3, 8, 15}) {
+            for (int k : {1, 4}) expectSameAsBrute(temp, width, height, win, win, k);
+        }
+        expectSameAsBrute(temp, width, height, 5, 2, 3);  // 정사각이 아닌 창
+    }
+}
+
+// 평평한 프레임: 합이 모두 같으면 행 우선 첫 위치부터, 겹치지 않는 창이 더 없을 때까지
+TEST(HotspotEngine, FlatFrameTiesAndExhaustion) {
+    const int width = 10, height = 6;
+    const std::vector<uint16_t> temp((size_t)width * height, 7300);
+    expectSameAsBrute(temp, width, height, 4, 3, 10);
+}
+
+TEST(HotspotEngine, MeanCelsiusMatchesDirectMean) {
+    std::mt19937 rng(9);
+    const int width = 64, height = 48;
+    const std::vector<uint16_t> temp = makeFrame(width, height, rng);
+    HotspotEngine engine;
+    engine.build(temp.data(), width, height);
+    double sum = 0.0;
+    for (int y = 10; y < 30; y++) {
+        for (int x = 5; x < 17; x++) sum += rawToKelvin30(clampRaw(temp[(size_t)y * width + x]));
+    }
+    EXPECT_NEAR(engine.meanCelsius(5, 10, 12, 20), kelvin30ToCelsius(sum / (12 * 20)), 1e-9);
+    EXPECT_EQ(engine.meanCelsius(60, 40, 12, 20), 0.0);  // 프레임 밖
+}
+
+// 14비트를 넘는 raw 로 가득 찬 최대 넓이 창: 클램프 덕분에 32비트 합이 넘치지 않는다
+TEST(HotspotEngine, SaturatedMaxWindowDoesNotOverflow) {
+    const int side = 400;  // 400 * 400 = kMaxWindowArea
+    ASSERT_LE((long)side * side, HotspotEngine::kMaxWindowArea);
+    const std::vector<uint16_t> temp((size_t)side * side, 0xFFFF);
+    HotspotEngine engine;
+    engine.build(temp.data(), side, side);
+    Hotspot hot;
+    ASSERT_EQ(engine.topK(side, side, 1, &hot), 1);
+    EXPECT_NEAR(hot.celsius, rawToCelsius(kRawLevels - 1), 1e-6);
+}
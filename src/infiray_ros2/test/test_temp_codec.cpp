@@ -0,0 +1,82 @@
+// decodeTempB (SIMD) 가 기준 구현 decodeTempBScalar 와 비트 단위로 같은지 확인한다.
+// 벡터 폭(AVX2 32, SSE2/NEON 16 픽셀)을 채우지 못하는 꼬리, 홀수 픽셀 수, 정렬되지 않은 버퍼를 포함한다.
+// CMake 가 같은 테스트를 경로별(-march=native, x86 에서는 -mno-avx2 로 SSE2)로 따로 빌드한다.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "infiray_ros2/temp_codec.hpp"
+
+using namespace infiray;
+
+namespace {
+
+constexpr uint16_t kSentinel = 0xDEAD;
+constexpr size_t kGuard = 64;  // 출력 뒤 보호 구역 (numPixels 를 넘어 쓰면 안 된다)
+
+void expectBitExact(size_t n, size_t offset, std::mt19937 &rng) {
+    std::vector<uint8_t> storage(n * 2 + offset);
+    for (auto &b : storage) b = (uint8_t)rng();
+    const uint8_t *buf = storage.data() + offset;
+
+    std::vector<uint16_t> ref(n + kGuard, kSentinel), simd(n + kGuard + 1, kSentinel);
+    decodeTempBScalar(buf, n, ref.data());
+    uint16_t *out = simd.data() + (offset & 1);  // 출력도 16바이트 경계에서 어긋나게
+    decodeTempB(buf, n, out);
+
+    for (size_t i = 0; i < n + kGuard; i++) {
+        ASSERT_EQ(ref[i], out[i]) << "path " << decodeTempBPath() << ", n=" << n << ", offset=" << offset
+                                  << ", i=" << i;
+    }
+}
+
+}  // namespace
+
+TEST(DecodeTempB, ReportsCompiledPath) {
+    const std::string path = decodeTempBPath();
+    EXPECT_TRUE(path == "avx2" || path == "sse2" || path == "neon" || path == "scalar") << path;
+}
+
+// 0 ~ 200 픽셀을 모두: 벡터 루프 0~여러 번 + SSE2/스칼라 꼬리 + 홀수 마지막 픽셀의 모든 조합
+TEST(DecodeTempB, MatchesScalarForEverySmallSize) {
+    std::mt19937 rng(7);
+    for (size_t n = 0; n <= 200; n++) {
+        for (size_t offset : {(size_t)0, (size_t)1, (size_t)3}) expectBitExact(n, offset, rng);
+    }
+}
+
+TEST(DecodeTempB, MatchesScalarForSensorResolutions) {
+    std::mt19937 rng(11);
+    for (size_t n : {(size_t)256 * 192, (size_t)384 * 288, (size_t)640 * 512, (size_t)1280 * 1024,
+                     (size_t)640 * 512 + 17, (size_t)4097}) {
+        expectBitExact(n, 0, rng);
+        expectBitExact(n, 5, rng);
+    }
+}
+
+// 모든 바이트 값이 상/하위 양쪽 자리에 나오도록 (무작위로는 드물게 빠질 수 있다)
+TEST(DecodeTempB, MatchesScalarForEveryByteValue) {
+    const size_t n = 512;
+    std::vector<uint8_t> buf(n * 2);
+    for (size_t i = 0; i < buf.size(); i++) buf[i] = (uint8_t)(i * 37 + (i >> 8));
+    std::vector<uint16_t> ref(n), simd(n);
+    decodeTempBScalar(buf.data(), n, ref.data());
+    decodeTempB(buf.data(), n, simd.data());
+    EXPECT_EQ(ref, simd);
+}
+
+// 합성/재생 소스가 쓰는 encodeTempB 의 역변환
+TEST(DecodeTempB, InvertsEncode) {
+    std::mt19937 rng(3);
+    const size_t n = 640 * 512;
+    std::vector<uint16_t> raw(n), back(n);
+    for (auto &v : raw) v = (uint16_t)(rng() & 0x3FFF);
+    std::vector<uint8_t> buf(n * 2);
+    encodeTempB(raw.data(), n, buf.data());
+    decodeTempB(buf.data(), n, back.data());
+    EXPECT_EQ(raw, back);
+}
@@ -1,12 +1,15 @@
+import mmap
+import struct
 import sys
 import threading
 import rclpy
 from rclpy.node import Node
 from rclpy.qos import qos_profile_sensor_data
-from sensor_msgs.msg import Image
+from sensor_msgs.msg import Image, CompressedImage
 from std_msgs.msg import Float32, Bool
 from cv_bridge import CvBridge
 import cv2
+import numpy as np
 
 from PyQt5.QtWidgets import *
 from PyQt5.QtGui import *
@@ -17,6 +20,58 @@ class ROS2Signals(QObject):
     temp_signal = pyqtSignal(float)
     fire_signal = pyqtSignal(bool)
 
+class ShmImageReader:
+    """노드와 같은 호스트일 때 공유 메모리 링(shm_ring.hpp 레이아웃)에서 최신 BGR 오버레이를 읽는다"""
+    MAGIC = b'IRSHM01\x00'
+    FORMAT_BGR8 = 2
+
+    def __init__(self, name):
+        self.path = '/dev/shm/' + name.lstrip('/')
+        self.mm = None
+        self.last_seq = 0
+
+    def _open(self):
+        try:
+            with open(self.path, 'rb') as f:
+                self.mm = mmap.mmap(f.fileno(), 0, prot=mmap.PROT_READ)
+        except (OSError, ValueError):
+            self.mm = None  # 노드가 아직 안 떴다
+            return False
+        if self.mm[0:8] != self.MAGIC:
+            self.mm.close()
+            self.mm = None
+            return False
+        self.slot_count, = struct.unpack_from('<I', self.mm, 12)
+        self.slot_stride, self.data_offset = struct.unpack_from('<QQ', self.mm, 24)
+        self.last_seq = 0
+        return True
+
+    def latest(self):
+        # 노드가 객체를 다시 만들었으면(stale) 다시 연다
+        if self.mm is not None and struct.unpack_from('<I', self.mm, 40)[0] != 0:
+            self.mm.close()
+            self.mm = None
+        if self.mm is None and not self._open():
+            return None
+        seq, = struct.unpack_from('<Q', self.mm, 48)
+        if seq == 0 or seq == self.last_seq:
+            return None
+        base = self.data_offset + ((seq - 1) % self.slot_count) * self.slot_stride
+        lock, slot_seq = struct.unpack_from('<QQ', self.mm, base)
+        if lock & 1 or slot_seq != seq:
+            return None
+        width, height, fmt, row_bytes = struct.unpack_from('<IIII', self.mm, base + 24)
+        if fmt != self.FORMAT_BGR8:
+            return None
+        img = np.frombuffer(self.mm, np.uint8, count=row_bytes * height, offset=base + 64).reshape(
+            height, width, 3).copy()
+        # 복사하는 사이 노드가 슬롯을 덮어썼으면 버린다 (seqlock)
+        if struct.unpack_from('<Q', self.mm, base)[0] != lock:
+            return None
+        self.last_seq = seq
+        return img
+
+
 class ThermalUINode(Node):
     def __init__(self, signals):
         super().__init__('thermal_ui_node')
@@ -27,8 +82,19 @@ class ThermalUINode(Node):
         self.latest_image = None
         self.image_lock = threading.Lock()
         
-        self.img_sub = self.create_subscription(
-            Image, '/thermal/image', self.image_callback, qos_profile_sensor_data)
+        # 같은 호스트면 shm_image:=/infiray_thermal_image 로 DDS 없이 공유 메모리에서 받는다 (노드 shm.enabled)
+        # 무선 링크에서는 압축 토픽(JPEG/PNG)을 받는다. 원본 bgr8 은 use_compressed:=false
+        shm_name = self.declare_parameter('shm_image', '').value
+        self.use_compressed = self.declare_parameter('use_compressed', True).value
+        self.shm_reader = ShmImageReader(shm_name) if shm_name else None
+        if self.shm_reader is not None:
+            self.img_sub = None
+        elif self.use_compressed:
+            self.img_sub = self.create_subscription(
+                CompressedImage, '/thermal/image/compressed', self.compressed_callback, qos_profile_sensor_data)
+        else:
+            self.img_sub = self.create_subscription(
+                Image, '/thermal/image', self.image_callback, qos_profile_sensor_data)
         self.temp_sub = self.create_subscription(
             Float32, '/thermal/max_temp', self.temp_callback, qos_profile_sensor_data)
         self.fire_sub = self.create_subscription(
@@ -40,6 +106,13 @@ class ThermalUINode(Node):
         with self.image_lock:
             self.latest_image = cv_img
 
+    def compressed_callback(self, msg):
+        cv_img = cv2.imdecode(np.frombuffer(msg.data, dtype=np.uint8), cv2.IMREAD_COLOR)
+        if cv_img is None:
+            return
+        with self.image_lock:
+            self.latest_image = cv_img
+
     def temp_callback(self, msg):
         self.signals.temp_signal.emit(msg.data)
 
@@ -111,6 +184,11 @@ class MainWindow(QMainWindow):
 
     def render_latest_image(self):
         # 타이머가 돌 때마다 공유 변수에서 '가장 최신' 이미지만 낚아채서 렌더링
+        if self.ros_node.shm_reader is not None:
+            img = self.ros_node.shm_reader.latest()
+            if img is not None:
+                with self.ros_node.image_lock:
+                    self.ros_node.latest_image = img
         with self.ros_node.image_lock:
             if self.ros_node.latest_image is None:
                 return